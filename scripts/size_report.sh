@@ -0,0 +1,92 @@
+#!/usr/bin/env bash
+#
+# Binary size report for the Enlil/GodotVST Framework
+#
+# Compares the dlopen build (make plugin, plus libgodot.so) with the
+# statically linked build (make plugin-static) side by side: file size,
+# loadable section sizes and the number of dynamic relocations the loader
+# has to process at startup. Load and first-frame times are not measured
+# here; the plugin only logs them per editor open
+# ("[FatSat] Editor open to first frame: ...").
+#
+# Usage: scripts/size_report.sh [dlopen bin dir] [static bin dir] [libgodot.so]
+
+set -euo pipefail
+
+DLOPEN_DIR="${1:-build/bin}"
+STATIC_DIR="${2:-build/bin-static}"
+LIBGODOT="${3:-godot/bin/libgodot.linuxbsd.template_release.x86_64.so}"
+
+file_bytes() {
+    if [ -f "$1" ]; then stat -c %s "$1"; else echo 0; fi
+}
+
+file_relocs() {
+    if [ -f "$1" ]; then
+        readelf -W -r "$1" 2>/dev/null | awk '/^Relocation section/ { n += $(NF - 1) } END { print n + 0 }'
+    else
+        echo 0
+    fi
+}
+
+report() {
+    local file="$1"
+    local bytes relocs
+
+    if [ ! -f "$file" ]; then
+        printf "  %-60s (not built)\n" "$file"
+        return
+    fi
+
+    bytes=$(file_bytes "$file")
+    relocs=$(file_relocs "$file")
+
+    printf "  %-60s %8.2f MiB  %8d relocs\n" "$file" "$(awk -v b="$bytes" 'BEGIN { print b / 1048576 }')" "$relocs"
+    size -A "$file" 2>/dev/null | awk '$1 ~ /^\.(text|rodata|data|data\.rel\.ro|bss)$/ {
+        printf "      %-14s %10.1f KiB\n", $1, $2 / 1024
+    }'
+}
+
+echo "== LibGodot (dlopen) =="
+report "$LIBGODOT"
+
+binaries() {
+    [ -d "$1" ] && find "$1" -type f \( -name '*.so' -o -name '*.clap' \) -printf '%P\n'
+    return 0
+}
+
+for dir in "$DLOPEN_DIR" "$STATIC_DIR"; do
+    echo ""
+    if [ "$dir" = "$DLOPEN_DIR" ]; then
+        echo "== Plugin binaries, dlopen build ($dir) =="
+    else
+        echo "== Plugin binaries, static build ($dir) =="
+    fi
+    if [ -d "$dir" ]; then
+        binaries "$dir" | sort | while read -r binary; do
+            report "$dir/$binary"
+        done
+    else
+        echo "  $dir not found, build it first"
+    fi
+done
+
+# The dlopen build also maps libgodot.so at editor open, so its total
+# is the plugin binary plus the library
+echo ""
+echo "== Static vs dlopen (plugin + libgodot.so) =="
+godot_bytes=$(file_bytes "$LIBGODOT")
+godot_relocs=$(file_relocs "$LIBGODOT")
+{ binaries "$DLOPEN_DIR"; binaries "$STATIC_DIR"; } | sort -u | while read -r binary; do
+    dlopen="$DLOPEN_DIR/$binary"
+    static="$STATIC_DIR/$binary"
+    if [ ! -f "$dlopen" ] || [ ! -f "$static" ]; then
+        printf "  %-40s (missing from one build)\n" "$binary"
+        continue
+    fi
+    awk -v name="$binary" \
+        -v db="$(( $(file_bytes "$dlopen") + godot_bytes ))" -v sb="$(file_bytes "$static")" \
+        -v dr="$(( $(file_relocs "$dlopen") + godot_relocs ))" -v sr="$(file_relocs "$static")" 'BEGIN {
+        printf "  %-40s %8.2f -> %8.2f MiB  %8d -> %8d relocs\n", name, db / 1048576, sb / 1048576, dr, sr
+    }'
+done
@@ -0,0 +1,175 @@
+/*
+ * Editor Spawner Implementation
+ * Part of the Enlil/GodotVST Framework
+ *
+ * A single Godot engine serves every FatSat editor in the host process.
+ * Each window gets its own instance of the editor scene, and so its own
+ * SubViewport. All SubViewports are drawn in the same iteration(), and each
+ * FrameExporter/InputInjector pair is bound to its window by editor ID.
+ */
+
+#include "editor_spawner.hpp"
+#include "frame_exporter.hpp"
+#include "input_injector.hpp"
+#include "../shared/frame_bridge.hpp"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/core/memory.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <algorithm>
+
+namespace godot {
+
+EditorSpawner::EditorSpawner()
+    : fGeneration(0),
+      fSpareEditor(nullptr)
+{
+}
+
+EditorSpawner::~EditorSpawner()
+{
+}
+
+void EditorSpawner::_exit_tree()
+{
+    // The spare is not in the tree, so nothing else frees it
+    if (fSpareEditor) {
+        memdelete(fSpareEditor);
+        fSpareEditor = nullptr;
+    }
+}
+
+void EditorSpawner::_process(double delta)
+{
+    (void)delta;
+
+    // Cheap check: only rescan when a window opened or closed
+    if (enlil::FrameBridge::getEditorGeneration() != fGeneration) {
+        sync_editors();
+    }
+}
+
+void EditorSpawner::sync_editors()
+{
+    fGeneration = enlil::FrameBridge::getEditorGeneration();
+
+    uint32_t ids[kMaxEditors];
+    const size_t count = std::min(enlil::FrameBridge::getEditorIds(ids, kMaxEditors), kMaxEditors);
+
+    // Free editors whose window has closed. Removing them from the tree
+    // right away disconnects their exporters before the next draw.
+    for (size_t i = 0; i < fEditors.size();) {
+        if (std::find(ids, ids + count, fEditors[i].first) != ids + count) {
+            ++i;
+            continue;
+        }
+
+        const uint32_t editorId = fEditors[i].first;
+        Node* editor = fEditors[i].second;
+        fEditors.erase(fEditors.begin() + i);
+
+        remove_child(editor);
+        editor->queue_free();
+        emit_signal("editor_closed", static_cast<int64_t>(editorId));
+
+        // A reopen is likely: have a fresh scene ready for it. The closed
+        // one is not reused, its nodes still hold that editor's state
+        // (pressed buttons, frame counters, knob values).
+        if (!fSpareEditor) {
+            fSpareEditor = instantiate_editor();
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        if (!get_editor(ids[i])) {
+            spawn_editor(ids[i]);
+        }
+    }
+}
+
+void EditorSpawner::spawn_editor(uint32_t editorId)
+{
+    Node* editor = fSpareEditor ? fSpareEditor : instantiate_editor();
+    fSpareEditor = nullptr;
+    if (!editor) {
+        return;
+    }
+
+    // Bind before add_child so the nodes see their ID in _ready()
+    editor->set_name(String("Editor") + String::num_int64(editorId));
+    editor->set_meta("editor_id", static_cast<int64_t>(editorId));
+    assign_editor_id(editor, editorId);
+
+    add_child(editor);
+    fEditors.emplace_back(editorId, editor);
+    emit_signal("editor_opened", static_cast<int64_t>(editorId), editor);
+}
+
+Node* EditorSpawner::instantiate_editor()
+{
+    if (fEditorScene.is_null()) {
+        UtilityFunctions::push_error("[EditorSpawner] No editor scene set!");
+        return nullptr;
+    }
+
+    Node* editor = fEditorScene->instantiate();
+    if (!editor) {
+        UtilityFunctions::push_error("[EditorSpawner] Failed to instantiate editor scene");
+    }
+    return editor;
+}
+
+void EditorSpawner::assign_editor_id(Node* node, uint32_t editorId)
+{
+    if (FrameExporter* exporter = Object::cast_to<FrameExporter>(node)) {
+        exporter->set_editor_id(editorId);
+    } else if (InputInjector* injector = Object::cast_to<InputInjector>(node)) {
+        injector->set_editor_id(editorId);
+    }
+
+    const int32_t childCount = node->get_child_count();
+    for (int32_t i = 0; i < childCount; ++i) {
+        assign_editor_id(node->get_child(i), editorId);
+    }
+}
+
+void EditorSpawner::set_editor_scene(const Ref<PackedScene>& scene)
+{
+    fEditorScene = scene;
+}
+
+Ref<PackedScene> EditorSpawner::get_editor_scene() const
+{
+    return fEditorScene;
+}
+
+int64_t EditorSpawner::get_editor_count() const
+{
+    return static_cast<int64_t>(fEditors.size());
+}
+
+Node* EditorSpawner::get_editor(int64_t editorId) const
+{
+    for (const auto& entry : fEditors) {
+        if (entry.first == editorId) {
+            return entry.second;
+        }
+    }
+    return nullptr;
+}
+
+void EditorSpawner::_bind_methods()
+{
+    ClassDB::bind_method(D_METHOD("set_editor_scene", "scene"), &EditorSpawner::set_editor_scene);
+    ClassDB::bind_method(D_METHOD("get_editor_scene"), &EditorSpawner::get_editor_scene);
+    ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "editor_scene", PROPERTY_HINT_RESOURCE_TYPE, "PackedScene"), "set_editor_scene", "get_editor_scene");
+
+    ClassDB::bind_method(D_METHOD("get_editor_count"), &EditorSpawner::get_editor_count);
+    ClassDB::bind_method(D_METHOD("get_editor", "editor_id"), &EditorSpawner::get_editor);
+
+    ADD_SIGNAL(MethodInfo("editor_opened", PropertyInfo(Variant::INT, "editor_id"), PropertyInfo(Variant::OBJECT, "editor")));
+    ADD_SIGNAL(MethodInfo("editor_closed", PropertyInfo(Variant::INT, "editor_id")));
+}
+
+} // namespace godot
@@ -0,0 +1,66 @@
+/*
+ * Editor Spawner - One editor scene per plugin window in a shared engine
+ * Instantiates the editor scene for every window registered with the
+ * FrameBridge and frees it when the window closes
+ * Part of the Enlil/GodotVST Framework
+ */
+
+#ifndef EDITOR_SPAWNER_HPP
+#define EDITOR_SPAWNER_HPP
+
+#include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/classes/packed_scene.hpp>
+#include <godot_cpp/core/class_db.hpp>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace godot {
+
+class EditorSpawner : public Node {
+    GDCLASS(EditorSpawner, Node)
+
+public:
+    EditorSpawner();
+    ~EditorSpawner();
+
+    void _process(double delta) override;
+    void _exit_tree() override;
+
+    // Scene instantiated per editor window (SubViewport + FrameExporter + InputInjector)
+    void set_editor_scene(const Ref<PackedScene>& scene);
+    Ref<PackedScene> get_editor_scene() const;
+
+    // Spawned editors
+    int64_t get_editor_count() const;
+    Node* get_editor(int64_t editor_id) const;
+
+protected:
+    static void _bind_methods();
+
+private:
+    // Upper bound on editor windows handled per sync
+    static constexpr size_t kMaxEditors = 64;
+
+    void sync_editors();
+    void spawn_editor(uint32_t editorId);
+    Node* instantiate_editor();
+    static void assign_editor_id(Node* node, uint32_t editorId);
+
+    Ref<PackedScene> fEditorScene;
+
+    // FrameBridge editor generation last synced
+    uint32_t fGeneration;
+
+    // Editor ID → scene root
+    std::vector<std::pair<uint32_t, Node*>> fEditors;
+
+    // Fresh editor scene instantiated when an editor closes, kept out of
+    // the tree for the next one so reopening does not wait for it
+    Node* fSpareEditor;
+};
+
+} // namespace godot
+
+#endif // EDITOR_SPAWNER_HPP
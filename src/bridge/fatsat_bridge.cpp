@@ -8,6 +8,8 @@
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
 
+#include "trace.hpp"
+
 namespace godot {
 
 FatSatBridge* FatSatBridge::singleton = nullptr;
@@ -96,6 +98,34 @@ void FatSatBridge::poll_visualization()
     }
 }
 
+void FatSatBridge::trace_begin(const String& name)
+{
+#ifdef ENLIL_TRACE
+    enlil::Tracer& tracer = enlil::Tracer::instance();
+    tracer.beginZone(tracer.intern(name.utf8().get_data()));
+#else
+    (void)name;
+#endif
+}
+
+void FatSatBridge::trace_end()
+{
+#ifdef ENLIL_TRACE
+    enlil::Tracer::instance().endZone();
+#endif
+}
+
+bool FatSatBridge::dump_trace(const String& path)
+{
+#ifdef ENLIL_TRACE
+    return enlil::Tracer::instance().dump(path.utf8().get_data());
+#else
+    (void)path;
+    UtilityFunctions::push_warning("[FatSatBridge] Built without ENLIL_TRACE, no trace to dump");
+    return false;
+#endif
+}
+
 void FatSatBridge::_bind_methods()
 {
     // Parameter properties
@@ -115,6 +145,11 @@ void FatSatBridge::_bind_methods()
 
     // Polling method
     ClassDB::bind_method(D_METHOD("poll_visualization"), &FatSatBridge::poll_visualization);
+
+    // Tracing
+    ClassDB::bind_method(D_METHOD("trace_begin", "name"), &FatSatBridge::trace_begin);
+    ClassDB::bind_method(D_METHOD("trace_end"), &FatSatBridge::trace_end);
+    ClassDB::bind_method(D_METHOD("dump_trace", "path"), &FatSatBridge::dump_trace);
 }
 
 } // namespace godot
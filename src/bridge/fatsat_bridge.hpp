@@ -39,6 +39,11 @@ public:
     // Called by UI thread to poll latest visualization data
     void poll_visualization();
 
+    // Timeline tracing (no-ops unless built with ENLIL_TRACE)
+    void trace_begin(const String& name);
+    void trace_end();
+    bool dump_trace(const String& path);
+
     // Singleton access
     static FatSatBridge* get_singleton();
 
@@ -13,7 +13,9 @@ namespace godot {
 
 FrameBridgeGD* FrameBridgeGD::singleton = nullptr;
 
-FrameBridgeGD::FrameBridgeGD() {
+FrameBridgeGD::FrameBridgeGD()
+    : fAlphaMode(ALPHA_STRAIGHT),
+      fEditorId(0) {
     singleton = this;
 }
 
@@ -27,6 +29,10 @@ FrameBridgeGD* FrameBridgeGD::get_singleton() {
     return singleton;
 }
 
+enlil::FrameBridge* FrameBridgeGD::bridge() const {
+    return enlil::FrameBridge::forEditor(fEditorId);
+}
+
 void FrameBridgeGD::submit_frame(const Ref<Image>& image) {
     if (image.is_null() || image->is_empty()) {
         return;
@@ -35,38 +41,93 @@ void FrameBridgeGD::submit_frame(const Ref<Image>& image) {
     int width = image->get_width();
     int height = image->get_height();
 
-    if (width <= 0 || height <= 0) {
+    enlil::FrameBridge* target = bridge();
+    if (!target || width <= 0 || height <= 0) {
         return;
     }
 
-    // Ensure image is in RGBA8 format
-    Ref<Image> rgba_image = image;
-    if (image->get_format() != Image::FORMAT_RGBA8) {
-        rgba_image = image->duplicate();
-        if (rgba_image.is_null()) {
-            return;
-        }
-        rgba_image->convert(Image::FORMAT_RGBA8);
+    // RGBA8 and RGB8 are converted straight into the frame slot
+    enlil::PixelFormat format;
+    Ref<Image> source = image;
+
+    switch (image->get_format()) {
+        case Image::FORMAT_RGBA8:
+            format = enlil::PIXEL_RGBA8;
+            break;
+
+        case Image::FORMAT_RGB8:
+            format = enlil::PIXEL_RGB8;
+            break;
+
+        default:
+            // Uncommon formats: convert through Image (allocates)
+            source = image->duplicate();
+            if (source.is_null()) {
+                return;
+            }
+            source->convert(Image::FORMAT_RGBA8);
+            format = enlil::PIXEL_RGBA8;
+            break;
     }
 
-    // Get raw pixel data
-    PackedByteArray data = rgba_image->get_data();
+    // Get raw pixel data (shares the Image's buffer, no copy)
+    PackedByteArray data = source->get_data();
     if (data.size() == 0) {
         return;
     }
 
     // Submit to the C++ bridge
-    enlil::FrameBridge::instance().submitFrame(
+    target->submitFrame(
         data.ptr(),
         width,
-        height
+        height,
+        format,
+        static_cast<enlil::AlphaMode>(fAlphaMode)
     );
 }
 
+void FrameBridgeGD::submit_frame_data(const PackedByteArray& data, int width, int height, PixelFormat format) {
+    enlil::FrameBridge* target = bridge();
+    if (!target || width <= 0 || height <= 0) {
+        return;
+    }
+
+    const int64_t bytesPerPixel = (format == FORMAT_RGB8) ? 3 : 4;
+    if (data.size() < static_cast<int64_t>(width) * height * bytesPerPixel) {
+        UtilityFunctions::push_error("[FrameBridgeGD] submit_frame_data: buffer too small");
+        return;
+    }
+
+    target->submitFrame(
+        data.ptr(),
+        width,
+        height,
+        static_cast<enlil::PixelFormat>(format),
+        static_cast<enlil::AlphaMode>(fAlphaMode)
+    );
+}
+
+void FrameBridgeGD::set_alpha_mode(AlphaMode mode) {
+    fAlphaMode = mode;
+}
+
+FrameBridgeGD::AlphaMode FrameBridgeGD::get_alpha_mode() const {
+    return fAlphaMode;
+}
+
+void FrameBridgeGD::set_editor_id(int64_t id) {
+    fEditorId = static_cast<uint32_t>(id);
+}
+
+int64_t FrameBridgeGD::get_editor_id() const {
+    return fEditorId;
+}
+
 Dictionary FrameBridgeGD::pop_input_event() {
     enlil::InputEvent event;
+    enlil::FrameBridge* source = bridge();
 
-    if (!enlil::FrameBridge::instance().popInputEvent(event)) {
+    if (!source || !source->popInputEvent(event)) {
         return Dictionary(); // Empty dictionary means no event
     }
 
@@ -102,28 +163,124 @@ Dictionary FrameBridgeGD::pop_input_event() {
             break;
     }
 
+    result["timestamp_usec"] = static_cast<int64_t>(event.timestamp / 1000u);
+
+    return result;
+}
+
+int64_t FrameBridgeGD::get_input_dropped_count() const {
+    const enlil::FrameBridge* source = bridge();
+    return source ? static_cast<int64_t>(source->getDroppedInputCount()) : 0;
+}
+
+int64_t FrameBridgeGD::get_input_coalesced_count() const {
+    const enlil::FrameBridge* source = bridge();
+    return source ? static_cast<int64_t>(source->getCoalescedInputCount()) : 0;
+}
+
+static Dictionary percentiles_to_dictionary(const enlil::FramePercentiles& percentiles) {
+    Dictionary result;
+    result["p50"] = percentiles.p50Us / 1000.0;
+    result["p95"] = percentiles.p95Us / 1000.0;
+    result["p99"] = percentiles.p99Us / 1000.0;
+    return result;
+}
+
+Dictionary FrameBridgeGD::get_frame_stats() const {
+    const enlil::FrameBridge* source = bridge();
+    if (!source) {
+        return Dictionary();
+    }
+
+    enlil::FrameStats stats;
+    source->getFrameStats(stats);
+
+    Dictionary result;
+    result["fps"] = stats.fps;
+    result["frame_count"] = static_cast<int64_t>(stats.frameCount);
+    result["presented"] = static_cast<int64_t>(stats.presentedFrames);
+    result["dropped"] = static_cast<int64_t>(stats.droppedFrames);
+    result["skipped"] = static_cast<int64_t>(stats.skippedFrames);
+    result["age"] = percentiles_to_dictionary(stats.age);
+
+    for (int stage = 0; stage < enlil::FRAME_STAGE_COUNT; ++stage) {
+        result[enlil::frameStageName(static_cast<enlil::FrameStage>(stage))] =
+            percentiles_to_dictionary(stats.stages[stage]);
+    }
+
     return result;
 }
 
+void FrameBridgeGD::reset_frame_stats() {
+    if (enlil::FrameBridge* target = bridge()) {
+        target->resetFrameStats();
+    }
+}
+
 Vector2i FrameBridgeGD::get_requested_size() {
     int width, height;
+    enlil::FrameBridge* source = bridge();
 
-    if (!enlil::FrameBridge::instance().getRequestedSize(width, height)) {
+    if (!source || !source->getRequestedSize(width, height)) {
         return Vector2i(0, 0); // No change
     }
 
     return Vector2i(width, height);
 }
 
+FrameBridgeGD::UIQuality FrameBridgeGD::get_ui_quality() const {
+    const enlil::FrameBridge* source = bridge();
+    return source ? static_cast<UIQuality>(source->getUIQuality()) : UI_QUALITY_FULL;
+}
+
+void FrameBridgeGD::set_state_value(const String& key, const String& value) {
+    if (enlil::FrameBridge* target = bridge()) {
+        target->setStateValue(key.utf8().get_data(), value.utf8().get_data());
+    }
+}
+
 void FrameBridgeGD::_bind_methods() {
     // Frame submission
     ClassDB::bind_method(D_METHOD("submit_frame", "image"), &FrameBridgeGD::submit_frame);
+    ClassDB::bind_method(D_METHOD("submit_frame_data", "data", "width", "height", "format"), &FrameBridgeGD::submit_frame_data);
+
+    ClassDB::bind_method(D_METHOD("set_alpha_mode", "mode"), &FrameBridgeGD::set_alpha_mode);
+    ClassDB::bind_method(D_METHOD("get_alpha_mode"), &FrameBridgeGD::get_alpha_mode);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "alpha_mode", PROPERTY_HINT_ENUM, "Straight,Premultiplied,Opaque"), "set_alpha_mode", "get_alpha_mode");
+
+    ClassDB::bind_method(D_METHOD("set_editor_id", "id"), &FrameBridgeGD::set_editor_id);
+    ClassDB::bind_method(D_METHOD("get_editor_id"), &FrameBridgeGD::get_editor_id);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "editor_id"), "set_editor_id", "get_editor_id");
+
+    BIND_ENUM_CONSTANT(FORMAT_RGBA8);
+    BIND_ENUM_CONSTANT(FORMAT_RGB8);
+    BIND_ENUM_CONSTANT(FORMAT_BGRA8);
+
+    BIND_ENUM_CONSTANT(ALPHA_STRAIGHT);
+    BIND_ENUM_CONSTANT(ALPHA_PREMULTIPLIED);
+    BIND_ENUM_CONSTANT(ALPHA_OPAQUE);
 
     // Input event polling
     ClassDB::bind_method(D_METHOD("pop_input_event"), &FrameBridgeGD::pop_input_event);
+    ClassDB::bind_method(D_METHOD("get_input_dropped_count"), &FrameBridgeGD::get_input_dropped_count);
+    ClassDB::bind_method(D_METHOD("get_input_coalesced_count"), &FrameBridgeGD::get_input_coalesced_count);
+
+    // Frame statistics
+    ClassDB::bind_method(D_METHOD("get_frame_stats"), &FrameBridgeGD::get_frame_stats);
+    ClassDB::bind_method(D_METHOD("reset_frame_stats"), &FrameBridgeGD::reset_frame_stats);
 
     // Resize handling
     ClassDB::bind_method(D_METHOD("get_requested_size"), &FrameBridgeGD::get_requested_size);
+
+    // Render quality
+    ClassDB::bind_method(D_METHOD("get_ui_quality"), &FrameBridgeGD::get_ui_quality);
+
+    BIND_ENUM_CONSTANT(UI_QUALITY_FULL);
+    BIND_ENUM_CONSTANT(UI_QUALITY_REDUCED);
+    BIND_ENUM_CONSTANT(UI_QUALITY_MINIMAL);
+
+    // Plugin state
+    ClassDB::bind_method(D_METHOD("set_state_value", "key", "value"), &FrameBridgeGD::set_state_value);
 }
 
 } // namespace godot
@@ -11,30 +11,93 @@
 #include <godot_cpp/classes/image.hpp>
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/string.hpp>
 #include <godot_cpp/variant/vector2i.hpp>
 
+#include <cstdint>
+
+namespace enlil {
+class FrameBridge;
+}
+
 namespace godot {
 
 class FrameBridgeGD : public Object {
     GDCLASS(FrameBridgeGD, Object)
 
 public:
+    // Raw pixel layouts for submit_frame_data (mirror enlil::PixelFormat)
+    enum PixelFormat {
+        FORMAT_RGBA8,
+        FORMAT_RGB8,
+        FORMAT_BGRA8
+    };
+
+    // Alpha handling for submitted frames (mirror enlil::AlphaMode)
+    enum AlphaMode {
+        ALPHA_STRAIGHT,
+        ALPHA_PREMULTIPLIED,
+        ALPHA_OPAQUE
+    };
+
+    // Render fidelity requested by the host (mirror enlil::UIQuality)
+    enum UIQuality {
+        UI_QUALITY_FULL,
+        UI_QUALITY_REDUCED,
+        UI_QUALITY_MINIMAL
+    };
+
     FrameBridgeGD();
     ~FrameBridgeGD();
 
     // Submit a rendered frame to the bridge
     // Called by FrameExporter.gd each frame
+    // RGBA8 and RGB8 images are converted directly into the frame slot,
+    // other formats fall back to an Image conversion
     void submit_frame(const Ref<Image>& image);
 
-    // Pop the next input event from the queue
+    // Submit raw pixel data (e.g. BGRA readback) without an Image
+    void submit_frame_data(const PackedByteArray& data, int width, int height, PixelFormat format);
+
+    // Alpha handling applied to submitted frames
+    void set_alpha_mode(AlphaMode mode);
+    AlphaMode get_alpha_mode() const;
+
+    // Editor window this wrapper talks to (0 = the default bridge)
+    void set_editor_id(int64_t id);
+    int64_t get_editor_id() const;
+
+    // Pop the next input event from the queue (allocates a Dictionary,
+    // use the InputInjector node for per-frame injection)
     // Returns empty Dictionary if no events available
-    // Dictionary keys: type (String), x, y (float), button (int), pressed (bool), keycode (int)
+    // Dictionary keys: type (String), x, y (float), button (int), pressed (bool), keycode (int),
+    // timestamp_usec (int, host monotonic time)
     Dictionary pop_input_event();
 
+    // Input queue accounting
+    int64_t get_input_dropped_count() const;
+    int64_t get_input_coalesced_count() const;
+
+    // Frame pipeline statistics over the last presented frames
+    // Dictionary keys: fps (float), frame_count, presented, dropped, skipped (int),
+    // age and one entry per stage (render, readback, submit, swap, upload,
+    // present), each a Dictionary with p50, p95, p99 in milliseconds
+    Dictionary get_frame_stats() const;
+    void reset_frame_stats();
+
     // Get the requested viewport size if it has changed
     // Returns Vector2i(0, 0) if size hasn't changed
     Vector2i get_requested_size();
 
+    // Fidelity the host's frame scheduler asks for while audio is under
+    // pressure; animations should pause at UI_QUALITY_MINIMAL
+    UIQuality get_ui_quality() const;
+
+    // Ask the host to set a plugin state, e.g. "curve" (see curve_table.hpp);
+    // the DPF UI forwards the latest value per key on its next idle
+    void set_state_value(const String& key, const String& value);
+
     // Singleton access
     static FrameBridgeGD* get_singleton();
 
@@ -43,8 +106,18 @@ protected:
 
 private:
     static FrameBridgeGD* singleton;
+
+    // nullptr once the editor window has closed
+    enlil::FrameBridge* bridge() const;
+
+    AlphaMode fAlphaMode;
+    uint32_t fEditorId;
 };
 
 } // namespace godot
 
+VARIANT_ENUM_CAST(godot::FrameBridgeGD::PixelFormat);
+VARIANT_ENUM_CAST(godot::FrameBridgeGD::AlphaMode);
+VARIANT_ENUM_CAST(godot::FrameBridgeGD::UIQuality);
+
 #endif // FRAME_BRIDGE_GD_HPP
@@ -0,0 +1,324 @@
+/*
+ * Frame Exporter Implementation
+ * Part of the Enlil/GodotVST Framework
+ *
+ * Runs after RenderingServer has drawn the frame (frame_post_draw), while
+ * Godot's GL context is current. The viewport's render target is read with
+ * glReadPixels straight into the FrameBridge back buffer, so there is no
+ * Image, PackedByteArray or Variant allocation per frame.
+ */
+
+#include "frame_exporter.hpp"
+
+#include <godot_cpp/classes/image.hpp>
+#include <godot_cpp/classes/rendering_server.hpp>
+#include <godot_cpp/classes/time.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include "trace.hpp"
+
+#if !defined(_WIN32)
+#define FRAME_EXPORTER_NATIVE_READ 1
+#define GL_GLEXT_PROTOTYPES
+#if defined(__APPLE__)
+#include <OpenGL/gl3.h>
+#else
+#include <GL/gl.h>
+#include <GL/glext.h>
+#endif
+#endif
+
+namespace godot {
+
+static constexpr int kSkipFrames = 5;
+static constexpr int kTimingReportFrames = 300;
+
+FrameExporter::FrameExporter()
+    : fViewportPath("../SubViewport"),
+      fSubViewport(nullptr),
+      fEditorId(0),
+      fAlphaMode(FrameBridgeGD::ALPHA_OPAQUE),
+      fFlipY(false),
+      fReportTiming(false),
+      fConnected(false),
+      fFrameCount(0),
+      fReadFramebuffer(0),
+      fNativeReadFailed(false),
+      fLastExportUsec(0),
+      fTimingSumUsec(0),
+      fTimingMaxUsec(0),
+      fTimingFrames(0)
+{
+}
+
+FrameExporter::~FrameExporter()
+{
+    // fReadFramebuffer is deleted in _exit_tree(), while Godot's context is current
+}
+
+void FrameExporter::_ready()
+{
+    fSubViewport = Object::cast_to<SubViewport>(get_node_or_null(fViewportPath));
+    if (!fSubViewport) {
+        UtilityFunctions::push_error("[FrameExporter] SubViewport not found!");
+        return;
+    }
+
+    RenderingServer* rs = RenderingServer::get_singleton();
+    rs->connect("frame_post_draw", callable_mp(this, &FrameExporter::_on_frame_post_draw));
+    fConnected = true;
+}
+
+void FrameExporter::_exit_tree()
+{
+    if (fConnected) {
+        RenderingServer::get_singleton()->disconnect(
+            "frame_post_draw", callable_mp(this, &FrameExporter::_on_frame_post_draw));
+        fConnected = false;
+    }
+    fSubViewport = nullptr;
+
+#if defined(FRAME_EXPORTER_NATIVE_READ)
+    // Godot's context outlives every editor, so the framebuffer would leak
+    // with each closed one. Nodes leave the tree during iteration() or the
+    // engine's shutdown, both with Godot's context current.
+    if (fReadFramebuffer != 0) {
+        glDeleteFramebuffers(1, &fReadFramebuffer);
+        fReadFramebuffer = 0;
+    }
+#endif
+}
+
+void FrameExporter::_on_frame_post_draw()
+{
+    if (!fSubViewport) {
+        return;
+    }
+
+    // Skip first few frames to let Godot fully initialize
+    if (fFrameCount < kSkipFrames) {
+        fFrameCount++;
+        return;
+    }
+
+    // The editor window may already be gone; its scene is freed next frame
+    enlil::FrameBridge* target = enlil::FrameBridge::forEditor(fEditorId);
+    if (!target) {
+        return;
+    }
+
+    ENLIL_TRACE_SCOPE("FrameExporter::export");
+
+    const uint64_t start = Time::get_singleton()->get_ticks_usec();
+    enlil::FrameBridge& bridge = *target;
+    bridge.markRenderEnd();
+
+    // Check for resize requests from the host (already debounced)
+    int width, height;
+    if (bridge.getRequestedSize(width, height) && width > 0 && height > 0) {
+        fSubViewport->set_size(Vector2i(width, height));
+        // The new size is rendered next frame, keep the last good frame
+        bridge.markFrameSkipped();
+        return;
+    }
+
+    // The host is throttling the UI: idle frames are read back less often
+    if (!bridge.shouldReadback()) {
+        bridge.markFrameSkipped();
+        return;
+    }
+
+    RenderingServer* rs = RenderingServer::get_singleton();
+    const Vector2i size = fSubViewport->get_size();
+    const RID texture = rs->viewport_get_texture(fSubViewport->get_viewport_rid());
+
+    if (!texture.is_valid() || size.x <= 0 || size.y <= 0) {
+        return;
+    }
+
+    const uint64_t nativeTexture = rs->texture_get_native_handle(texture);
+    if (nativeTexture == 0 || fNativeReadFailed || !read_render_target(bridge, nativeTexture, size.x, size.y)) {
+        read_image_fallback(bridge, texture);
+    }
+
+    fLastExportUsec = static_cast<int64_t>(Time::get_singleton()->get_ticks_usec() - start);
+
+    if (fReportTiming) {
+        fTimingSumUsec += fLastExportUsec;
+        if (fLastExportUsec > fTimingMaxUsec) {
+            fTimingMaxUsec = fLastExportUsec;
+        }
+
+        if (++fTimingFrames >= kTimingReportFrames) {
+            UtilityFunctions::print("[FrameExporter] native export: avg ",
+                fTimingSumUsec / fTimingFrames, " us, max ", fTimingMaxUsec, " us");
+            fTimingSumUsec = 0;
+            fTimingMaxUsec = 0;
+            fTimingFrames = 0;
+        }
+    }
+}
+
+bool FrameExporter::read_render_target(enlil::FrameBridge& bridge, uint64_t texture, int width, int height)
+{
+#if defined(FRAME_EXPORTER_NATIVE_READ)
+    GLint previousFramebuffer = 0;
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previousFramebuffer);
+
+    if (fReadFramebuffer == 0) {
+        glGenFramebuffers(1, &fReadFramebuffer);
+    }
+
+    // Re-attach every frame: Godot recreates the texture on resize and
+    // may reuse the same name
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fReadFramebuffer);
+    glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                           static_cast<GLuint>(texture), 0);
+
+    if (glCheckFramebufferStatus(GL_READ_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, previousFramebuffer);
+        UtilityFunctions::push_warning("[FrameExporter] Render target not readable, using Image fallback");
+        fNativeReadFailed = true;
+        return false;
+    }
+
+    uint8_t* dst = bridge.beginFrame(width, height);
+
+    // BGRA is the native readback order on desktop drivers; the host
+    // uploads it with GL_BGRA so no swizzle happens on the CPU
+    {
+        ENLIL_TRACE_SCOPE("glReadPixels");
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        glReadBuffer(GL_COLOR_ATTACHMENT0);
+        glReadPixels(0, 0, width, height, GL_BGRA, GL_UNSIGNED_BYTE, dst);
+    }
+    bridge.markReadbackEnd();
+
+    if (fAlphaMode == FrameBridgeGD::ALPHA_PREMULTIPLIED) {
+        enlil::pixel::premultiply32(dst, dst, static_cast<size_t>(width) * height);
+    }
+
+    {
+        ENLIL_TRACE_SCOPE("FrameBridge::commitFrame");
+        bridge.commitFrame(enlil::PIXEL_BGRA8, static_cast<enlil::AlphaMode>(fAlphaMode), fFlipY);
+    }
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, previousFramebuffer);
+    return true;
+#else
+    (void)bridge;
+    (void)texture;
+    (void)width;
+    (void)height;
+    return false;
+#endif
+}
+
+void FrameExporter::read_image_fallback(enlil::FrameBridge& bridge, const RID& texture)
+{
+    // Allocates an Image per frame; only used when the render target
+    // cannot be read directly (non-GL renderer)
+    Ref<Image> image = RenderingServer::get_singleton()->texture_2d_get(texture);
+    if (image.is_null() || image->is_empty()) {
+        return;
+    }
+
+    if (image->get_format() != Image::FORMAT_RGBA8) {
+        image->convert(Image::FORMAT_RGBA8);
+    }
+
+    PackedByteArray data = image->get_data();
+    bridge.markReadbackEnd();
+
+    ENLIL_TRACE_SCOPE("FrameBridge::submitFrame");
+    bridge.submitFrame(
+        data.ptr(),
+        image->get_width(),
+        image->get_height(),
+        enlil::PIXEL_RGBA8,
+        static_cast<enlil::AlphaMode>(fAlphaMode)
+    );
+}
+
+void FrameExporter::set_viewport_path(const NodePath& path)
+{
+    fViewportPath = path;
+}
+
+NodePath FrameExporter::get_viewport_path() const
+{
+    return fViewportPath;
+}
+
+void FrameExporter::set_editor_id(int64_t id)
+{
+    fEditorId = static_cast<uint32_t>(id);
+}
+
+int64_t FrameExporter::get_editor_id() const
+{
+    return fEditorId;
+}
+
+void FrameExporter::set_alpha_mode(FrameBridgeGD::AlphaMode mode)
+{
+    fAlphaMode = mode;
+}
+
+FrameBridgeGD::AlphaMode FrameExporter::get_alpha_mode() const
+{
+    return fAlphaMode;
+}
+
+void FrameExporter::set_flip_y(bool flip)
+{
+    fFlipY = flip;
+}
+
+bool FrameExporter::get_flip_y() const
+{
+    return fFlipY;
+}
+
+void FrameExporter::set_report_timing(bool enabled)
+{
+    fReportTiming = enabled;
+}
+
+bool FrameExporter::get_report_timing() const
+{
+    return fReportTiming;
+}
+
+int64_t FrameExporter::get_last_export_usec() const
+{
+    return fLastExportUsec;
+}
+
+void FrameExporter::_bind_methods()
+{
+    ClassDB::bind_method(D_METHOD("set_viewport_path", "path"), &FrameExporter::set_viewport_path);
+    ClassDB::bind_method(D_METHOD("get_viewport_path"), &FrameExporter::get_viewport_path);
+    ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "viewport_path", PROPERTY_HINT_NODE_PATH_VALID_TYPES, "SubViewport"), "set_viewport_path", "get_viewport_path");
+
+    ClassDB::bind_method(D_METHOD("set_editor_id", "id"), &FrameExporter::set_editor_id);
+    ClassDB::bind_method(D_METHOD("get_editor_id"), &FrameExporter::get_editor_id);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "editor_id"), "set_editor_id", "get_editor_id");
+
+    ClassDB::bind_method(D_METHOD("set_alpha_mode", "mode"), &FrameExporter::set_alpha_mode);
+    ClassDB::bind_method(D_METHOD("get_alpha_mode"), &FrameExporter::get_alpha_mode);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "alpha_mode", PROPERTY_HINT_ENUM, "Straight,Premultiplied,Opaque"), "set_alpha_mode", "get_alpha_mode");
+
+    ClassDB::bind_method(D_METHOD("set_flip_y", "flip"), &FrameExporter::set_flip_y);
+    ClassDB::bind_method(D_METHOD("get_flip_y"), &FrameExporter::get_flip_y);
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "flip_y"), "set_flip_y", "get_flip_y");
+
+    ClassDB::bind_method(D_METHOD("set_report_timing", "enabled"), &FrameExporter::set_report_timing);
+    ClassDB::bind_method(D_METHOD("get_report_timing"), &FrameExporter::get_report_timing);
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "report_timing"), "set_report_timing", "get_report_timing");
+
+    ClassDB::bind_method(D_METHOD("get_last_export_usec"), &FrameExporter::get_last_export_usec);
+}
+
+} // namespace godot
@@ -0,0 +1,88 @@
+/*
+ * Frame Exporter - Native replacement for frame_exporter.gd
+ * Copies SubViewport frames to the FrameBridge after each frame is drawn
+ * Part of the Enlil/GodotVST Framework
+ */
+
+#ifndef FRAME_EXPORTER_HPP
+#define FRAME_EXPORTER_HPP
+
+#include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/classes/sub_viewport.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/node_path.hpp>
+
+#include "frame_bridge_gd.hpp"
+#include "../shared/frame_bridge.hpp"
+
+#include <cstdint>
+
+namespace godot {
+
+class FrameExporter : public Node {
+    GDCLASS(FrameExporter, Node)
+
+public:
+    FrameExporter();
+    ~FrameExporter();
+
+    void _ready() override;
+    void _exit_tree() override;
+
+    // SubViewport to export (default: ../SubViewport)
+    void set_viewport_path(const NodePath& path);
+    NodePath get_viewport_path() const;
+
+    // Editor window receiving the frames (0 = the default bridge)
+    void set_editor_id(int64_t id);
+    int64_t get_editor_id() const;
+
+    // Alpha handling for exported frames
+    void set_alpha_mode(FrameBridgeGD::AlphaMode mode);
+    FrameBridgeGD::AlphaMode get_alpha_mode() const;
+
+    // Mark readbacks as bottom-up (driver dependent render target layout)
+    void set_flip_y(bool flip);
+    bool get_flip_y() const;
+
+    // Print average/max export time every 300 frames
+    void set_report_timing(bool enabled);
+    bool get_report_timing() const;
+
+    // Export time of the last frame in microseconds
+    int64_t get_last_export_usec() const;
+
+protected:
+    static void _bind_methods();
+
+private:
+    void _on_frame_post_draw();
+    bool read_render_target(enlil::FrameBridge& bridge, uint64_t texture, int width, int height);
+    void read_image_fallback(enlil::FrameBridge& bridge, const RID& texture);
+
+    NodePath fViewportPath;
+    SubViewport* fSubViewport;
+    uint32_t fEditorId;
+    FrameBridgeGD::AlphaMode fAlphaMode;
+    bool fFlipY;
+    bool fReportTiming;
+    bool fConnected;
+
+    // Skip first few frames to let Godot fully initialize
+    int fFrameCount;
+
+    // Framebuffer used to read the viewport texture (in Godot's context,
+    // deleted when the exporter leaves the tree)
+    unsigned int fReadFramebuffer;
+    bool fNativeReadFailed;
+
+    // Timing (microseconds)
+    int64_t fLastExportUsec;
+    int64_t fTimingSumUsec;
+    int64_t fTimingMaxUsec;
+    int fTimingFrames;
+};
+
+} // namespace godot
+
+#endif // FRAME_EXPORTER_HPP
@@ -0,0 +1,252 @@
+/*
+ * Input Injector Implementation
+ * Part of the Enlil/GodotVST Framework
+ *
+ * Events are drained from the FrameBridge in batches and turned into
+ * InputEventMouseMotion/Button/Key objects in C++. The event objects are
+ * pooled: each is reused as long as nothing else holds a reference to it
+ * after push_input(), so plain mouse motion allocates nothing per frame.
+ */
+
+#include "input_injector.hpp"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+namespace godot {
+
+// Reuse the pooled event unless a receiver kept a reference to it
+template <typename T>
+static T* reuse_event(Ref<T>& pooled)
+{
+    if (pooled.is_null() || pooled->get_reference_count() > 1) {
+        pooled.instantiate();
+    }
+    return pooled.ptr();
+}
+
+// DPF uses 1=left, 2=middle, 3=right
+static MouseButton dpf_button_to_godot(int button)
+{
+    switch (button) {
+    case 2:
+        return MOUSE_BUTTON_MIDDLE;
+    case 3:
+        return MOUSE_BUTTON_RIGHT;
+    default:
+        return MOUSE_BUTTON_LEFT;
+    }
+}
+
+InputInjector::InputInjector()
+    : fViewportPath("../SubViewport"),
+      fSubViewport(nullptr),
+      fEditorId(0),
+      fButtonMask(0),
+      fScale(1.0f, 1.0f)
+{
+}
+
+InputInjector::~InputInjector()
+{
+}
+
+void InputInjector::_ready()
+{
+    fSubViewport = Object::cast_to<SubViewport>(get_node_or_null(fViewportPath));
+    if (!fSubViewport) {
+        UtilityFunctions::push_error("[InputInjector] SubViewport not found!");
+        return;
+    }
+
+    fMotionEvent.instantiate();
+    fButtonEvent.instantiate();
+    fKeyEvent.instantiate();
+}
+
+void InputInjector::_process(double delta)
+{
+    (void)delta;
+
+    if (!fSubViewport) {
+        return;
+    }
+
+    enlil::FrameBridge* source = enlil::FrameBridge::forEditor(fEditorId);
+    if (!source) {
+        return;
+    }
+
+    enlil::FrameBridge& bridge = *source;
+
+    // Host coordinates are window-relative; scale them while the viewport
+    // still has the old size during a resize
+    int windowWidth, windowHeight;
+    bridge.getCurrentSize(windowWidth, windowHeight);
+    const Vector2i viewportSize = fSubViewport->get_size();
+    fScale = Vector2(
+        windowWidth > 0 ? (float)viewportSize.x / (float)windowWidth : 1.0f,
+        windowHeight > 0 ? (float)viewportSize.y / (float)windowHeight : 1.0f
+    );
+
+    // Process all pending input events
+    size_t count;
+    while ((count = bridge.popInputEvents(fBatch, kBatchSize)) > 0) {
+        for (size_t i = 0; i < count; ++i) {
+            inject(fBatch[i]);
+        }
+    }
+}
+
+void InputInjector::inject(const enlil::InputEvent& event)
+{
+    switch (event.type) {
+    case enlil::InputEvent::MOUSE_MOTION:
+        inject_motion(to_viewport(event.x, event.y));
+        break;
+
+    case enlil::InputEvent::MOUSE_BUTTON:
+        inject_button(to_viewport(event.x, event.y), event.button, event.pressed);
+        break;
+
+    case enlil::InputEvent::SCROLL:
+        inject_scroll(to_viewport(event.x, event.y), event.scrollX, event.scrollY);
+        break;
+
+    case enlil::InputEvent::KEY:
+        inject_key(event.button, event.pressed);
+        break;
+    }
+}
+
+Vector2 InputInjector::to_viewport(float x, float y) const
+{
+    return Vector2(x * fScale.x, y * fScale.y);
+}
+
+void InputInjector::inject_motion(const Vector2& pos)
+{
+    InputEventMouseMotion* event = reuse_event(fMotionEvent);
+    event->set_position(pos);
+    event->set_global_position(pos);
+    event->set_relative(pos - fLastMousePosition);
+    event->set_button_mask(fButtonMask);
+
+    fLastMousePosition = pos;
+
+    // Coordinates are already viewport-local; this also avoids the
+    // per-event copy push_input makes when converting coordinates
+    fSubViewport->push_input(fMotionEvent, true);
+}
+
+void InputInjector::inject_button(const Vector2& pos, int button, bool pressed)
+{
+    const MouseButton index = dpf_button_to_godot(button);
+
+    // Update button mask
+    const int64_t maskBit = int64_t(1) << (int64_t(index) - 1);
+    int64_t mask = int64_t(fButtonMask);
+    mask = pressed ? (mask | maskBit) : (mask & ~maskBit);
+    fButtonMask = BitField<MouseButtonMask>(mask);
+
+    InputEventMouseButton* event = reuse_event(fButtonEvent);
+    event->set_position(pos);
+    event->set_global_position(pos);
+    event->set_button_index(index);
+    event->set_pressed(pressed);
+    event->set_factor(1.0f);
+    event->set_button_mask(fButtonMask);
+
+    fLastMousePosition = pos;
+
+    fSubViewport->push_input(fButtonEvent, true);
+
+    // Also send a motion event to update position
+    if (pressed) {
+        InputEventMouseMotion* motion = reuse_event(fMotionEvent);
+        motion->set_position(pos);
+        motion->set_global_position(pos);
+        motion->set_relative(Vector2());
+        motion->set_button_mask(fButtonMask);
+        fSubViewport->push_input(fMotionEvent, true);
+    }
+}
+
+void InputInjector::push_wheel(const Vector2& pos, MouseButton button, float factor)
+{
+    InputEventMouseButton* event = reuse_event(fButtonEvent);
+    event->set_position(pos);
+    event->set_global_position(pos);
+    event->set_button_index(button);
+    event->set_factor(factor);
+    event->set_button_mask(fButtonMask);
+    event->set_pressed(true);
+    fSubViewport->push_input(fButtonEvent, true);
+
+    // Release
+    event = reuse_event(fButtonEvent);
+    event->set_position(pos);
+    event->set_global_position(pos);
+    event->set_button_index(button);
+    event->set_factor(factor);
+    event->set_button_mask(fButtonMask);
+    event->set_pressed(false);
+    fSubViewport->push_input(fButtonEvent, true);
+}
+
+void InputInjector::inject_scroll(const Vector2& pos, float scrollX, float scrollY)
+{
+    // Scroll events are button events in Godot
+    if (scrollY != 0.0f) {
+        push_wheel(pos, scrollY > 0.0f ? MOUSE_BUTTON_WHEEL_UP : MOUSE_BUTTON_WHEEL_DOWN,
+                   scrollY > 0.0f ? scrollY : -scrollY);
+    }
+
+    if (scrollX != 0.0f) {
+        push_wheel(pos, scrollX < 0.0f ? MOUSE_BUTTON_WHEEL_LEFT : MOUSE_BUTTON_WHEEL_RIGHT,
+                   scrollX > 0.0f ? scrollX : -scrollX);
+    }
+}
+
+void InputInjector::inject_key(int keycode, bool pressed)
+{
+    InputEventKey* event = reuse_event(fKeyEvent);
+    event->set_keycode(static_cast<Key>(keycode));
+    event->set_physical_keycode(static_cast<Key>(keycode));
+    event->set_pressed(pressed);
+
+    fSubViewport->push_input(fKeyEvent, true);
+}
+
+void InputInjector::set_viewport_path(const NodePath& path)
+{
+    fViewportPath = path;
+}
+
+NodePath InputInjector::get_viewport_path() const
+{
+    return fViewportPath;
+}
+
+void InputInjector::set_editor_id(int64_t id)
+{
+    fEditorId = static_cast<uint32_t>(id);
+}
+
+int64_t InputInjector::get_editor_id() const
+{
+    return fEditorId;
+}
+
+void InputInjector::_bind_methods()
+{
+    ClassDB::bind_method(D_METHOD("set_viewport_path", "path"), &InputInjector::set_viewport_path);
+    ClassDB::bind_method(D_METHOD("get_viewport_path"), &InputInjector::get_viewport_path);
+    ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "viewport_path", PROPERTY_HINT_NODE_PATH_VALID_TYPES, "SubViewport"), "set_viewport_path", "get_viewport_path");
+
+    ClassDB::bind_method(D_METHOD("set_editor_id", "id"), &InputInjector::set_editor_id);
+    ClassDB::bind_method(D_METHOD("get_editor_id"), &InputInjector::get_editor_id);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "editor_id"), "set_editor_id", "get_editor_id");
+}
+
+} // namespace godot
@@ -0,0 +1,79 @@
+/*
+ * Input Injector - Native replacement for input_receiver.gd
+ * Drains the FrameBridge input queue and pushes Godot input events
+ * into the target SubViewport
+ * Part of the Enlil/GodotVST Framework
+ */
+
+#ifndef INPUT_INJECTOR_HPP
+#define INPUT_INJECTOR_HPP
+
+#include <godot_cpp/classes/input_event_key.hpp>
+#include <godot_cpp/classes/input_event_mouse_button.hpp>
+#include <godot_cpp/classes/input_event_mouse_motion.hpp>
+#include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/classes/sub_viewport.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/node_path.hpp>
+#include <godot_cpp/variant/vector2.hpp>
+
+#include "../shared/frame_bridge.hpp"
+
+namespace godot {
+
+class InputInjector : public Node {
+    GDCLASS(InputInjector, Node)
+
+public:
+    InputInjector();
+    ~InputInjector();
+
+    void _ready() override;
+    void _process(double delta) override;
+
+    // SubViewport receiving the events (default: ../SubViewport)
+    void set_viewport_path(const NodePath& path);
+    NodePath get_viewport_path() const;
+
+    // Editor window the input comes from (0 = the default bridge)
+    void set_editor_id(int64_t id);
+    int64_t get_editor_id() const;
+
+protected:
+    static void _bind_methods();
+
+private:
+    // Events drained from the bridge per batch
+    static constexpr size_t kBatchSize = 64;
+
+    void inject(const enlil::InputEvent& event);
+    void inject_motion(const Vector2& pos);
+    void inject_button(const Vector2& pos, int button, bool pressed);
+    void inject_scroll(const Vector2& pos, float scrollX, float scrollY);
+    void inject_key(int keycode, bool pressed);
+    void push_wheel(const Vector2& pos, MouseButton button, float factor);
+    Vector2 to_viewport(float x, float y) const;
+
+    NodePath fViewportPath;
+    SubViewport* fSubViewport;
+    uint32_t fEditorId;
+
+    // Drain buffer, reused every frame
+    enlil::InputEvent fBatch[kBatchSize];
+
+    // Pooled events, re-instantiated only if a receiver kept a reference
+    Ref<InputEventMouseMotion> fMotionEvent;
+    Ref<InputEventMouseButton> fButtonEvent;
+    Ref<InputEventKey> fKeyEvent;
+
+    // Track mouse state for motion events
+    Vector2 fLastMousePosition;
+    BitField<MouseButtonMask> fButtonMask;
+
+    // Window → viewport scale (differs while a resize is settling)
+    Vector2 fScale;
+};
+
+} // namespace godot
+
+#endif // INPUT_INJECTOR_HPP
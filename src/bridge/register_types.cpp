@@ -4,8 +4,11 @@
  */
 
 #include "register_types.hpp"
+#include "editor_spawner.hpp"
 #include "fatsat_bridge.hpp"
 #include "frame_bridge_gd.hpp"
+#include "frame_exporter.hpp"
+#include "input_injector.hpp"
 
 #include <gdextension_interface.h>
 #include <godot_cpp/core/defs.hpp>
@@ -21,6 +24,9 @@ void initialize_fatsat_module(ModuleInitializationLevel p_level)
 
     ClassDB::register_class<FatSatBridge>();
     ClassDB::register_class<FrameBridgeGD>();
+    ClassDB::register_class<FrameExporter>();
+    ClassDB::register_class<InputInjector>();
+    ClassDB::register_class<EditorSpawner>();
 }
 
 void uninitialize_fatsat_module(ModuleInitializationLevel p_level)
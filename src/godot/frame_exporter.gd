@@ -1,14 +1,33 @@
 extends Node
 ## Frame Exporter - Copies SubViewport frames to the FrameBridge
 ## Part of the Enlil/GodotVST Framework
+##
+## GDScript reference implementation. editor.tscn uses the native
+## FrameExporter node; this script is kept to compare per-frame cost
+## (enable report_timing on both and compare the printed averages).
+
+## Alpha handling for exported frames. The FatSat UI has a full-size
+## background, so alpha can be dropped and the host skips blending.
+@export var alpha_mode: FrameBridgeGD.AlphaMode = FrameBridgeGD.ALPHA_OPAQUE
+
+## Print average/max export time every 300 frames
+@export var report_timing: bool = false
 
 var bridge: FrameBridgeGD
 var sub_viewport: SubViewport
 var frame_count: int = 0
 
+var _timing_sum_usec: int = 0
+var _timing_max_usec: int = 0
+var _timing_frames: int = 0
+
 func _ready() -> void:
 	# Create bridge instance
 	bridge = FrameBridgeGD.new()
+	# EditorSpawner tags each editor scene with the window it belongs to
+	if owner:
+		bridge.editor_id = owner.get_meta("editor_id", 0)
+	bridge.alpha_mode = alpha_mode
 
 	# Get reference to SubViewport
 	sub_viewport = get_node("../SubViewport")
@@ -25,6 +44,8 @@ func _process(_delta: float) -> void:
 	if frame_count < 5:
 		return
 
+	var start_usec := Time.get_ticks_usec()
+
 	# Check for resize requests from the host
 	var new_size := bridge.get_requested_size()
 	if new_size != Vector2i.ZERO:
@@ -40,3 +61,18 @@ func _process(_delta: float) -> void:
 		return
 
 	bridge.submit_frame(image)
+
+	if report_timing:
+		_report_timing(Time.get_ticks_usec() - start_usec)
+
+func _report_timing(elapsed_usec: int) -> void:
+	_timing_sum_usec += elapsed_usec
+	_timing_max_usec = maxi(_timing_max_usec, elapsed_usec)
+	_timing_frames += 1
+
+	if _timing_frames >= 300:
+		print("[FrameExporter] gdscript export: avg ", _timing_sum_usec / _timing_frames,
+			" us, max ", _timing_max_usec, " us")
+		_timing_sum_usec = 0
+		_timing_max_usec = 0
+		_timing_frames = 0
@@ -1,6 +1,10 @@
 extends Node
 ## Input Receiver - Polls input events from FrameBridge and injects into Godot
 ## Part of the Enlil/GodotVST Framework
+##
+## GDScript reference implementation. editor.tscn uses the native
+## InputInjector node, which drains the queue in batches and reuses
+## its InputEvent objects instead of building Dictionaries per event.
 
 var bridge: FrameBridgeGD
 var sub_viewport: SubViewport
@@ -12,6 +16,9 @@ var mouse_button_mask := 0
 func _ready() -> void:
 	# Create bridge instance
 	bridge = FrameBridgeGD.new()
+	# EditorSpawner tags each editor scene with the window it belongs to
+	if owner:
+		bridge.editor_id = owner.get_meta("editor_id", 0)
 
 	# Get reference to SubViewport for input injection
 	sub_viewport = get_node("../SubViewport")
@@ -12,6 +12,9 @@ extends Control
 # DSP bridge for parameter sync
 var dsp_bridge: FatSatBridge
 
+# This editor's frame bridge, for the host's render quality
+var frame_bridge: FrameBridgeGD
+
 # Knob state
 var fatness_value: float = 0.0
 var is_dragging: bool = false
@@ -36,6 +39,11 @@ func _ready() -> void:
 	# Create DSP bridge instance
 	dsp_bridge = FatSatBridge.new()
 
+	# The editor scene root carries the window's editor ID (EditorSpawner)
+	frame_bridge = FrameBridgeGD.new()
+	if owner and owner.has_meta("editor_id"):
+		frame_bridge.set_editor_id(owner.get_meta("editor_id"))
+
 	# Set up knob for input
 	fatness_knob.mouse_filter = Control.MOUSE_FILTER_STOP
 
@@ -45,10 +53,21 @@ func _ready() -> void:
 
 	print("[PluginUI] Initialized")
 
+func _exit_tree() -> void:
+	if frame_bridge:
+		frame_bridge.free()
+		frame_bridge = null
+
 func _process(delta: float) -> void:
 	if not dsp_bridge:
 		return
 
+	# The host is short on CPU for audio: hold the meters until it recovers
+	if frame_bridge and frame_bridge.get_ui_quality() == FrameBridgeGD.UI_QUALITY_MINIMAL:
+		return
+
+	dsp_bridge.trace_begin("PluginUI._process")
+
 	# Poll visualization data from DSP
 	dsp_bridge.poll_visualization()
 
@@ -69,6 +88,8 @@ func _process(delta: float) -> void:
 
 	_update_meters()
 
+	dsp_bridge.trace_end()
+
 func _gui_input(event: InputEvent) -> void:
 	# Handle input on the main control
 	pass
@@ -172,3 +193,19 @@ func set_fatness(value: float) -> void:
 	fatness_value = clampf(value, 0.0, 1.0)
 	_update_knob_visual()
 	_update_value_label()
+
+# Shape the saturation with a drawn curve: points on the positive half,
+# x from 0 to 1 strictly increasing, y in -1..1 (mirrored for negative input).
+# Safe to call on every drag motion; the DSP only builds the latest curve.
+func set_curve(points: PackedVector2Array) -> void:
+	if not frame_bridge:
+		return
+	var parts := PackedStringArray()
+	for point in points:
+		parts.append("%f %f" % [point.x, point.y])
+	frame_bridge.set_state_value("curve", " ".join(parts))
+
+# Back to the built-in tanh curve
+func clear_curve() -> void:
+	if frame_bridge:
+		frame_bridge.set_state_value("curve", "")
@@ -0,0 +1,117 @@
+extends Node
+## Shader Warm-up - Renders every canvas item variant used by FatSat off-screen
+## Part of the Enlil/GodotVST Framework
+##
+## The gl_compatibility renderer compiles canvas shader variants and
+## rasterizes font glyphs the first time they are drawn, which shows up as
+## hitches on the first hover or knob drag. This autoload draws the same kinds
+## of items as editor.tscn (rects, styleboxes, rotated panels, MSDF text with
+## every glyph the UI can display, lines and polygons, translucent and
+## modulated items) into a hidden SubViewport for a few frames, then frees it.
+## Compiled programs end up in Godot's shader cache in the project's user
+## dir, so later opens skip compilation entirely.
+
+signal finished
+
+## Frames to keep the warm-up viewport alive
+const WARMUP_FRAMES: int = 3
+
+## Every character the UI can display (title, labels, value readout)
+const GLYPHS: String = "FatSat FATNESS 0123456789%"
+
+var _viewport: SubViewport
+var _frames_left: int = WARMUP_FRAMES
+var _start_usec: int = 0
+
+func _ready() -> void:
+	_start_usec = Time.get_ticks_usec()
+
+	# Same target setup as the editor SubViewport
+	_viewport = SubViewport.new()
+	_viewport.transparent_bg = true
+	_viewport.size = Vector2i(128, 128)
+	_viewport.render_target_update_mode = SubViewport.UPDATE_ALWAYS
+	_viewport.gui_disable_input = true
+	add_child(_viewport)
+
+	var root := Control.new()
+	root.size = Vector2(128, 128)
+	_viewport.add_child(root)
+
+	_add_items(root)
+
+	RenderingServer.frame_post_draw.connect(_on_frame_post_draw)
+
+func _add_items(root: Control) -> void:
+	# Plain rect (background, meters)
+	var rect := ColorRect.new()
+	rect.color = Color(0.12, 0.12, 0.15, 1.0)
+	rect.size = Vector2(128, 128)
+	root.add_child(rect)
+
+	# Themed panel, also rotated like the knob
+	var panel := Panel.new()
+	panel.size = Vector2(48, 48)
+	panel.position = Vector2(40, 40)
+	panel.rotation_degrees = 30.0
+	root.add_child(panel)
+
+	# Rounded, bordered, anti-aliased stylebox with shadow
+	var style := StyleBoxFlat.new()
+	style.bg_color = Color(0.2, 0.2, 0.24, 1.0)
+	style.set_corner_radius_all(8)
+	style.set_border_width_all(2)
+	style.border_color = Color(0.9, 0.5, 0.1, 1.0)
+	style.shadow_size = 4
+	style.anti_aliasing = true
+	var styled := Panel.new()
+	styled.size = Vector2(40, 24)
+	styled.add_theme_stylebox_override("panel", style)
+	root.add_child(styled)
+
+	# MSDF text with every glyph the UI shows, at the theme's font size
+	var label := Label.new()
+	label.text = GLYPHS
+	root.add_child(label)
+
+	# Button states use different styleboxes
+	for state in ["normal", "hover", "pressed"]:
+		var button := Button.new()
+		button.text = "0%"
+		button.add_theme_stylebox_override("normal", button.get_theme_stylebox(state))
+		root.add_child(button)
+
+	# Translucent and modulated items use the blend variants
+	var overlay := ColorRect.new()
+	overlay.color = Color(0.9, 0.5, 0.1, 0.5)
+	overlay.size = Vector2(64, 64)
+	overlay.modulate = Color(1.0, 1.0, 1.0, 0.75)
+	root.add_child(overlay)
+
+	# Lines, arcs and polygons (primitive and attribute variants)
+	var shapes := _WarmupShapes.new()
+	shapes.size = Vector2(128, 128)
+	root.add_child(shapes)
+
+func _on_frame_post_draw() -> void:
+	_frames_left -= 1
+	if _frames_left > 0:
+		return
+
+	RenderingServer.frame_post_draw.disconnect(_on_frame_post_draw)
+	_viewport.queue_free()
+	_viewport = null
+
+	print("[ShaderWarmup] Warmed up canvas shaders in %.1f ms" %
+		((Time.get_ticks_usec() - _start_usec) / 1000.0))
+	finished.emit()
+
+class _WarmupShapes extends Control:
+	func _draw() -> void:
+		draw_line(Vector2(4, 4), Vector2(60, 30), Color.WHITE, 2.0)
+		draw_line(Vector2(4, 8), Vector2(60, 40), Color.WHITE, 2.0, true)
+		draw_polyline(PackedVector2Array([Vector2(0, 0), Vector2(20, 30), Vector2(40, 10)]), Color.WHITE, 1.5, true)
+		draw_arc(Vector2(64, 64), 30.0, 0.0, PI, 32, Color.WHITE, 3.0, true)
+		draw_circle(Vector2(96, 96), 12.0, Color(0.2, 0.8, 0.3, 1.0))
+		draw_colored_polygon(PackedVector2Array([Vector2(0, 128), Vector2(64, 90), Vector2(128, 128)]), Color(1.0, 0.2, 0.1, 0.8))
+		draw_rect(Rect2(8, 96, 24, 24), Color.WHITE, false, 1.0)
@@ -0,0 +1,227 @@
+/*
+ * FatSat Blitter - Uploads FrameBridge frames to a GL texture and draws them
+ * Part of the Enlil/GodotVST Framework
+ */
+
+#include "FatSatBlitter.hpp"
+
+#include <cstdio>
+
+// OpenGL headers
+#if defined(__APPLE__)
+#include <OpenGL/gl.h>
+#else
+#include <GL/gl.h>
+#endif
+
+#ifndef GL_BGRA
+#define GL_BGRA 0x80E1
+#endif
+
+START_NAMESPACE_DISTRHO
+
+// Grow a texture dimension geometrically (1.5x, 64px aligned) so that a
+// window drag only reallocates the GL texture a few times. A dimension
+// that still fits keeps its size; none grows past the GL limit.
+static int textureCapacityBucket(int needed, int current, int maximum)
+{
+    if (needed <= current) {
+        return current;
+    }
+    int capacity = current > 0 ? current + current / 2 : needed;
+    if (capacity < needed) {
+        capacity = needed;
+    }
+    capacity = (capacity + 63) & ~63;
+    return capacity < maximum ? capacity : maximum;
+}
+
+FrameBlitter::FrameBlitter()
+    : fTexture(0),
+      fInitialized(false),
+      fTextureWidth(0),
+      fTextureHeight(0),
+      fMaxTextureSize(0),
+      fFrameWidth(0),
+      fFrameHeight(0),
+      fFrameAlphaMode(enlil::ALPHA_STRAIGHT),
+      fFrameBottomUp(false)
+{
+}
+
+void FrameBlitter::init()
+{
+    if (fInitialized) {
+        return;
+    }
+
+    // Generate texture for frame display
+    glGenTextures(1, &fTexture);
+    glBindTexture(GL_TEXTURE_2D, fTexture);
+
+    // Set texture parameters
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    GLint maxTextureSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+    fMaxTextureSize = maxTextureSize > 0 ? maxTextureSize : 4096;
+
+    fInitialized = true;
+}
+
+void FrameBlitter::cleanup()
+{
+    if (fTexture != 0) {
+        glDeleteTextures(1, &fTexture);
+        fTexture = 0;
+    }
+    fTextureWidth = 0;
+    fTextureHeight = 0;
+    fInitialized = false;
+}
+
+bool FrameBlitter::upload(enlil::FrameBridge& bridge)
+{
+    // Check if we have a new frame
+    if (!bridge.hasNewFrame()) {
+        return false;
+    }
+
+    const uint8_t* data = bridge.getFrameData();
+    int width = bridge.getFrameWidth();
+    int height = bridge.getFrameHeight();
+
+    if (!data || width <= 0 || height <= 0) {
+        return false;
+    }
+
+    // The GPU cannot hold the frame; keep showing the last one
+    if (width > fMaxTextureSize || height > fMaxTextureSize) {
+        return false;
+    }
+
+    // BGRA frames are swizzled by GL during upload, no CPU conversion
+    const GLenum uploadFormat =
+        (bridge.getFrameFormat() == enlil::PIXEL_BGRA8) ? GL_BGRA : GL_RGBA;
+
+    glBindTexture(GL_TEXTURE_2D, fTexture);
+
+    // Only reallocate when the frame outgrows the texture; never shrink
+    if (width > fTextureWidth || height > fTextureHeight) {
+        fTextureWidth = textureCapacityBucket(width, fTextureWidth, fMaxTextureSize);
+        fTextureHeight = textureCapacityBucket(height, fTextureHeight, fMaxTextureSize);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, fTextureWidth, fTextureHeight, 0,
+                     uploadFormat, GL_UNSIGNED_BYTE, nullptr);
+    }
+
+    // Update the used region of the texture
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height,
+                    uploadFormat, GL_UNSIGNED_BYTE, data);
+    bridge.markFrameUploaded();
+    fFrameWidth = width;
+    fFrameHeight = height;
+    fFrameAlphaMode = bridge.getFrameAlphaMode();
+    fFrameBottomUp = bridge.isFrameBottomUp();
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return true;
+}
+
+void FrameBlitter::draw(int width, int height)
+{
+    if (fFrameWidth <= 0 || fFrameHeight <= 0) {
+        return;
+    }
+
+    // The frame occupies the top-left part of the texture. It is stretched
+    // over the whole window, so while a resize settles the last good frame
+    // is scaled instead of waiting for Godot to render at the new size.
+    // GL_LINEAR must not reach the texels past the frame, which were never
+    // written: at 1:1 every pixel centre lands on a texel centre, scaled
+    // frames are inset by half a texel.
+    const float inset = (width != fFrameWidth || height != fFrameHeight) ? 0.5f : 0.0f;
+    const float u0 = inset / (float)fTextureWidth;
+    const float u1 = ((float)fFrameWidth - inset) / (float)fTextureWidth;
+    const float v0 = inset / (float)fTextureHeight;
+    const float v1 = ((float)fFrameHeight - inset) / (float)fTextureHeight;
+
+    // Bottom-up frames (GL readbacks) are flipped via texture coordinates
+    const float vTop = fFrameBottomUp ? v1 : v0;
+    const float vBottom = fFrameBottomUp ? v0 : v1;
+
+    // Save OpenGL state
+    glPushAttrib(GL_ENABLE_BIT | GL_TEXTURE_BIT);
+
+    // Setup for 2D rendering
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_LIGHTING);
+    glEnable(GL_TEXTURE_2D);
+
+    // Opaque frames replace the background, no blending needed
+    switch (fFrameAlphaMode) {
+    case enlil::ALPHA_OPAQUE:
+        glDisable(GL_BLEND);
+        break;
+    case enlil::ALPHA_PREMULTIPLIED:
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+        break;
+    default:
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        break;
+    }
+
+    // Setup orthographic projection
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    glOrtho(0, width, height, 0, -1, 1);
+
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+
+    // Bind texture and draw quad
+    glBindTexture(GL_TEXTURE_2D, fTexture);
+    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+
+    glBegin(GL_QUADS);
+    // Top-left
+    glTexCoord2f(u0, vTop);
+    glVertex2f(0.0f, 0.0f);
+    // Top-right
+    glTexCoord2f(u1, vTop);
+    glVertex2f((float)width, 0.0f);
+    // Bottom-right
+    glTexCoord2f(u1, vBottom);
+    glVertex2f((float)width, (float)height);
+    // Bottom-left
+    glTexCoord2f(u0, vBottom);
+    glVertex2f(0.0f, (float)height);
+    glEnd();
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    // Restore matrices
+    glMatrixMode(GL_MODELVIEW);
+    glPopMatrix();
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+
+    // Restore OpenGL state
+    glPopAttrib();
+
+    // Check for GL errors
+    GLenum err = glGetError();
+    if (err != GL_NO_ERROR) {
+        fprintf(stderr, "[FatSat] GL error in FrameBlitter::draw: 0x%x\n", err);
+    }
+}
+
+END_NAMESPACE_DISTRHO
@@ -0,0 +1,57 @@
+/*
+ * FatSat Blitter - Uploads FrameBridge frames to a GL texture and draws them
+ * Part of the Enlil/GodotVST Framework
+ *
+ * The host side of the frame pipeline, independent of DPF's UI class so the
+ * same code runs in the plugin window and in the offscreen UI benchmark.
+ * All methods must be called with the target GL context current.
+ */
+
+#ifndef FATSAT_BLITTER_HPP
+#define FATSAT_BLITTER_HPP
+
+#include "DistrhoUtils.hpp"
+#include "../shared/frame_bridge.hpp"
+
+START_NAMESPACE_DISTRHO
+
+class FrameBlitter {
+public:
+    FrameBlitter();
+
+    // Create / delete the texture (needs the GL context, so not in the
+    // constructor or destructor)
+    void init();
+    void cleanup();
+    bool isInitialized() const { return fInitialized; }
+
+    // Swap in the bridge's newest frame and upload it
+    // Returns true if a new frame was uploaded
+    bool upload(enlil::FrameBridge& bridge);
+
+    // Draw the last uploaded frame stretched over a width x height viewport
+    void draw(int width, int height);
+
+    bool hasFrame() const { return fFrameWidth > 0; }
+    bool isOpaque() const { return fFrameAlphaMode == enlil::ALPHA_OPAQUE; }
+    int getFrameWidth() const { return fFrameWidth; }
+    int getFrameHeight() const { return fFrameHeight; }
+
+private:
+    // Texture size is a capacity bucket, the frame uses the top-left part
+    unsigned int fTexture;
+    bool fInitialized;
+    int fTextureWidth;
+    int fTextureHeight;
+    int fMaxTextureSize;
+    int fFrameWidth;
+    int fFrameHeight;
+    enlil::AlphaMode fFrameAlphaMode;
+    bool fFrameBottomUp;
+
+    DISTRHO_DECLARE_NON_COPYABLE(FrameBlitter)
+};
+
+END_NAMESPACE_DISTRHO
+
+#endif // FATSAT_BLITTER_HPP
@@ -0,0 +1,470 @@
+/*
+ * FatSat Engine - Process-wide LibGodot engine shared by all editor windows
+ * Part of the Enlil/GodotVST Framework
+ */
+
+// X11/GLX headers must come BEFORE DPF headers to avoid Window naming conflict
+#if !defined(__APPLE__)
+#include <X11/Xlib.h>
+#include <GL/glx.h>
+#endif
+
+#include "FatSatEngine.hpp"
+#include "FatSatInstances.hpp"
+#include "../shared/frame_bridge.hpp"
+#include "../shared/trace.hpp"
+#include "../bridge/editor_spawner.hpp"
+#include "../bridge/fatsat_bridge.hpp"
+#include "../bridge/frame_bridge_gd.hpp"
+#include "../bridge/frame_exporter.hpp"
+#include "../bridge/input_injector.hpp"
+
+#include <godot_cpp/classes/os.hpp>
+#include <godot_cpp/classes/rendering_server.hpp>
+
+#include <algorithm>
+#include <dlfcn.h>
+#include <cstdio>
+#include <cstdlib>
+
+START_NAMESPACE_DISTRHO
+
+// GDExtension initialization callbacks (using godot-cpp pattern)
+extern "C" {
+
+static void fatsat_initialize_module(godot::ModuleInitializationLevel p_level) {
+    if (p_level != godot::MODULE_INITIALIZATION_LEVEL_SCENE) {
+        return;
+    }
+
+    // Register GDExtension classes so GDScript can use them
+    godot::ClassDB::register_class<godot::FatSatBridge>();
+    godot::ClassDB::register_class<godot::FrameBridgeGD>();
+    godot::ClassDB::register_class<godot::FrameExporter>();
+    godot::ClassDB::register_class<godot::InputInjector>();
+    godot::ClassDB::register_class<godot::EditorSpawner>();
+
+    fprintf(stdout, "[FatSat] GDExtension module initialized - registered FatSatBridge, FrameBridgeGD, FrameExporter, InputInjector and EditorSpawner\n");
+}
+
+static void fatsat_uninitialize_module(godot::ModuleInitializationLevel p_level) {
+    if (p_level != godot::MODULE_INITIALIZATION_LEVEL_SCENE) {
+        return;
+    }
+    fprintf(stdout, "[FatSat] GDExtension module uninitialized\n");
+}
+
+GDExtensionBool GDE_EXPORT fatsat_gdextension_init(
+    GDExtensionInterfaceGetProcAddress p_get_proc_address,
+    GDExtensionClassLibraryPtr p_library,
+    GDExtensionInitialization* r_initialization)
+{
+    fprintf(stdout, "[FatSat] GDExtension init called\n");
+
+    godot::GDExtensionBinding::InitObject init_object(p_get_proc_address, p_library, r_initialization);
+
+    init_object.register_initializer(fatsat_initialize_module);
+    init_object.register_terminator(fatsat_uninitialize_module);
+    init_object.set_minimum_library_initialization_level(godot::MODULE_INITIALIZATION_LEVEL_SCENE);
+
+    return init_object.init();
+}
+
+} // extern "C"
+
+static uint32_t envOrDefault(const char* name, uint32_t fallback)
+{
+    const char* value = std::getenv(name);
+    if (!value || *value == '\0') {
+        return fallback;
+    }
+    return static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+}
+
+GodotEngineHost& GodotEngineHost::instance()
+{
+    // Destroyed when the plugin binary is unloaded; by then the engine was
+    // shut down with the last plugin instance
+    static GodotEngineHost host;
+    return host;
+}
+
+GodotEngineHost::GodotEngineHost()
+    : fNextEditorId(1),
+      fLastIterationNs(0),
+      fMinIterationIntervalNs(kDefaultMinIterationIntervalNs),
+      fIterationCount(0),
+      fStage(kStageIdle),
+      fLibGodotHandle(nullptr),
+      fCreateInstance(nullptr),
+      fDestroyInstance(nullptr),
+      fGodotInstance(nullptr),
+      fUsingEmbeddedPck(false),
+      fKeepWarm(true),
+      fIdleTimeoutSec(envOrDefault("FATSAT_ENGINE_IDLE_TIMEOUT", kDefaultIdleTimeoutSec)),
+      fMemoryBudgetMiB(envOrDefault("FATSAT_ENGINE_MEMORY_BUDGET", kDefaultMemoryBudgetMiB)),
+      fIdleSinceNs(0),
+      fDisplayDriver(nullptr)
+{
+    PluginInstances::setDestroyCallback(&GodotEngineHost::pluginDestroyed);
+}
+
+GodotEngineHost::~GodotEngineHost()
+{
+    PluginInstances::setDestroyCallback(nullptr);
+
+    // Only reached with a live engine if the host exits without destroying
+    // its plugin instances. This may run on any thread and after the host
+    // closed its display, so Godot is left to the OS rather than torn down.
+    if (fGodotInstance) {
+        fprintf(stderr, "[FatSat] Godot engine still running at unload, not shutting it down
+");
+    }
+    fLibGodotLoader.cancel();
+}
+
+void GodotEngineHost::pluginDestroyed(bool last)
+{
+    GodotEngineHost& host = instance();
+
+    // Editors normally close before their plugin instance is destroyed
+    if (!host.fEditors.empty()) {
+        return;
+    }
+
+    if (last) {
+        // No instance is left to open an editor: release everything, the
+        // loader thread included, before the host can unload the binary
+        host.fLibGodotLoader.wait();
+        if (host.fGodotInstance) {
+            fprintf(stdout, "[FatSat] Last plugin instance destroyed, shutting down Godot engine\n");
+        }
+        host.shutdownGodot();
+        host.unloadLibGodot();
+        return;
+    }
+
+    if (host.isIdleExpired()) {
+        fprintf(stdout, "[FatSat] Warm engine idle for %.0f s, shutting it down\n",
+                (enlil::hostTimeNs() - host.fIdleSinceNs) / 1.0e9);
+        host.shutdownGodot();
+    }
+}
+
+bool GodotEngineHost::isIdleExpired() const
+{
+    if (!fEditors.empty() || fStage != kStageRunning || fIdleSinceNs == 0) {
+        return false;
+    }
+    const uint64_t idleNs = enlil::hostTimeNs() - fIdleSinceNs;
+    return idleNs > static_cast<uint64_t>(fIdleTimeoutSec) * 1000000000ULL;
+}
+
+uint32_t GodotEngineHost::acquire()
+{
+    // A warm engine that sat idle past its timeout is restarted, not resumed
+    if (isIdleExpired()) {
+        fprintf(stdout, "[FatSat] Warm engine idle for %.0f s, restarting\n",
+                (enlil::hostTimeNs() - fIdleSinceNs) / 1.0e9);
+        shutdownGodot();
+    }
+
+    const uint32_t editorId = fNextEditorId++;
+    enlil::FrameBridge::openEditor(editorId);
+    fEditors.push_back(editorId);
+    fIdleSinceNs = 0;
+
+    switch (fStage) {
+    case kStageIdle:
+    case kStageFailed:
+        if (fCreateInstance) {
+            fStage = kStageCreating;
+        } else {
+            fStage = kStageLoadingLibrary;
+            fLibGodotLoader.start();
+        }
+        break;
+
+    case kStageRunning:
+        fprintf(stdout, "[FatSat] Reusing warm Godot engine (%zu editor(s))\n", fEditors.size());
+        break;
+
+    default:
+        // Boot already in progress
+        break;
+    }
+
+    return editorId;
+}
+
+void GodotEngineHost::release(uint32_t editorId)
+{
+    // The editor's scene is freed by EditorSpawner on the next iteration
+    fEditors.erase(std::remove(fEditors.begin(), fEditors.end(), editorId), fEditors.end());
+    enlil::FrameBridge::closeEditor(editorId);
+
+    if (!fEditors.empty()) {
+        return;
+    }
+
+    fIdleSinceNs = enlil::hostTimeNs();
+
+    // The loader thread runs code from this binary, which the host may
+    // unload once its last editor is gone: let the load finish now. The
+    // next acquire() picks up the library.
+    if (fStage == kStageLoadingLibrary) {
+        fLibGodotLoader.wait();
+    }
+
+    if (fStage != kStageRunning) {
+        return;
+    }
+
+    const uint64_t usage = getMemoryUsage();
+    const uint64_t budget = static_cast<uint64_t>(fMemoryBudgetMiB) << 20;
+
+    if (!fKeepWarm || fIdleTimeoutSec == 0 || usage > budget) {
+        fprintf(stdout, "[FatSat] Releasing Godot engine (%.1f MiB, budget %u MiB)\n",
+                usage / 1048576.0, fMemoryBudgetMiB);
+        shutdownGodot();
+        return;
+    }
+
+    fprintf(stdout, "[FatSat] Keeping Godot engine warm (%.1f MiB, idle timeout %u s)\n",
+            usage / 1048576.0, fIdleTimeoutSec);
+}
+
+void GodotEngineHost::advanceStartup()
+{
+    switch (fStage) {
+    case kStageLoadingLibrary:
+        switch (fLibGodotLoader.getState()) {
+        case LibGodotLoader::kStateReady:
+            if (fLibGodotLoader.take(fLibGodotHandle, fCreateInstance, fDestroyInstance)) {
+                if (LibGodotLoader::isStaticallyLinked()) {
+                    fprintf(stdout, "[FatSat] LibGodot linked statically\n");
+                } else {
+                    fprintf(stdout, "[FatSat] LibGodot loaded in background (%.1f ms)\n",
+                            fLibGodotLoader.getLoadTimeMs());
+                }
+                fStage = kStageCreating;
+            }
+            break;
+        case LibGodotLoader::kStateFailed:
+            fStage = kStageFailed;
+            break;
+        default:
+            break;
+        }
+        break;
+
+    case kStageCreating:
+        fStage = initGodot() ? kStageStarting : kStageFailed;
+        break;
+
+    case kStageStarting:
+        startGodot();
+        fStage = kStageRunning;
+        break;
+
+    default:
+        break;
+    }
+}
+
+bool GodotEngineHost::iterate()
+{
+    if (fStage != kStageRunning || fEditors.empty()) {
+        return false;
+    }
+
+    // Every open editor calls this from its own uiIdle(); one frame
+    // renders all of them, so don't run more often than a single editor
+    // would, nor more often than the most throttled editor asks for
+    uint64_t intervalNs = fMinIterationIntervalNs;
+    for (const uint32_t editorId : fEditors) {
+        if (const enlil::FrameBridge* bridge = enlil::FrameBridge::forEditor(editorId)) {
+            intervalNs = std::max(intervalNs, bridge->getFrameInterval());
+        }
+    }
+
+    const uint64_t now = enlil::hostTimeNs();
+    if (now - fLastIterationNs < intervalNs) {
+        return false;
+    }
+    fLastIterationNs = now;
+    fIterationCount++;
+
+    ENLIL_TRACE_SCOPE("GodotEngineHost::iterate");
+
+#if !defined(__APPLE__)
+    // Switch to Godot's OpenGL context before iteration
+    fGodotContext.makeCurrent();
+#endif
+
+    // Timestamp the frame every open editor is about to render
+    for (const uint32_t editorId : fEditors) {
+        if (enlil::FrameBridge* bridge = enlil::FrameBridge::forEditor(editorId)) {
+            bridge->markRenderStart();
+        }
+    }
+
+    // Run Godot's frame with its context now active
+    {
+        ENLIL_TRACE_SCOPE("GodotInstance::iteration");
+        fGodotInstance->iteration();
+    }
+
+#if !defined(__APPLE__)
+    // Ensure Godot's rendering is complete
+    {
+        ENLIL_TRACE_SCOPE("glFinish");
+        glFinish();
+    }
+
+    // Unbind context - DPF will bind its own in onDisplay()
+    fGodotContext.release();
+#endif
+
+    return true;
+}
+
+uint64_t GodotEngineHost::getMemoryUsage() const
+{
+    if (fStage != kStageRunning) {
+        return 0;
+    }
+
+    uint64_t usage = godot::OS::get_singleton()->get_static_memory_usage();
+    usage += godot::RenderingServer::get_singleton()->get_rendering_info(
+        godot::RenderingServer::RENDERING_INFO_VIDEO_MEM_USED);
+    return usage;
+}
+
+bool GodotEngineHost::initGodot()
+{
+    if (!fCreateInstance) {
+        return false;
+    }
+
+    fUsingEmbeddedPck = false;
+
+    // Prefer the PCK embedded in the binary; fall back to the loose project
+    // directory (FATSAT_GODOT_PROJECT overrides the default relative path)
+    const char* projectArg = "--path";
+    const char* projectPath = std::getenv("FATSAT_GODOT_PROJECT");
+
+    if (!projectPath) {
+        projectPath = "src/godot";
+        if (const char* packPath = fEmbeddedPck.open()) {
+            projectArg = "--main-pack";
+            projectPath = packPath;
+            fUsingEmbeddedPck = true;
+        }
+    }
+
+    const char* displayDriver = std::getenv("FATSAT_GODOT_DISPLAY_DRIVER");
+    if (!displayDriver || *displayDriver == '\0') {
+        displayDriver = fDisplayDriver;
+    }
+
+    // Build command line arguments for Godot
+    // Godot creates its own window for rendering. We extract frames via FrameBridge.
+    const char* args[] = {
+        "fatsat",
+        projectArg, projectPath,
+        "--rendering-method", "gl_compatibility",
+        "--rendering-driver", "opengl3",
+        nullptr, nullptr,
+        nullptr
+    };
+
+    int argc = 0;
+    while (args[argc] != nullptr) {
+        ++argc;
+    }
+
+    if (displayDriver) {
+        args[argc++] = "--display-driver";
+        args[argc++] = displayDriver;
+    }
+
+    fprintf(stdout, "[FatSat] Creating Godot instance with offscreen window, %d args (%s %s)\n",
+            argc, projectArg, projectPath);
+
+    // Create the Godot instance using 3-arg signature
+    GDExtensionObjectPtr instancePtr = fCreateInstance(argc, (char**)args, fatsat_gdextension_init);
+
+    if (!instancePtr) {
+        fprintf(stderr, "[FatSat] Failed to create Godot instance\n");
+        return false;
+    }
+
+    // Get the godot-cpp wrapper for the instance
+    fGodotInstance = reinterpret_cast<godot::GodotInstance*>(
+        godot::internal::get_object_instance_binding(instancePtr)
+    );
+
+    if (!fGodotInstance) {
+        fprintf(stderr, "[FatSat] Failed to get GodotInstance binding\n");
+        return false;
+    }
+
+    return true;
+}
+
+void GodotEngineHost::startGodot()
+{
+    fprintf(stdout, "[FatSat] Godot instance created, starting engine...\n");
+
+    // Start the engine using godot-cpp method
+    fGodotInstance->start();
+
+#if !defined(__APPLE__)
+    // Capture Godot's GL context right after start() while it's still current.
+    // We'll need this to restore the context before each iteration().
+    fGodotContext.captureCurrent();
+#endif
+}
+
+void GodotEngineHost::shutdownGodot()
+{
+    if (fGodotInstance && fDestroyInstance) {
+#if !defined(__APPLE__)
+        // Nodes release their GL objects as they leave the tree
+        fGodotContext.makeCurrent();
+#endif
+
+        // Get the raw object pointer for destruction
+        GDExtensionObjectPtr obj = godot::internal::gdextension_interface_object_get_instance_from_id(
+            fGodotInstance->get_instance_id()
+        );
+        fDestroyInstance(obj);
+        fGodotInstance = nullptr;
+
+#if !defined(__APPLE__)
+        fGodotContext.release();
+#endif
+        fprintf(stdout, "[FatSat] Godot instance destroyed\n");
+    }
+
+    fGodotContext.clear();
+
+    fEmbeddedPck.close();
+
+    if (fStage == kStageRunning || fStage == kStageStarting) {
+        fStage = kStageIdle;
+    }
+}
+
+void GodotEngineHost::unloadLibGodot()
+{
+    if (fLibGodotHandle) {
+        dlclose(fLibGodotHandle);
+        fLibGodotHandle = nullptr;
+    }
+    fCreateInstance = nullptr;
+    fDestroyInstance = nullptr;
+}
+
+END_NAMESPACE_DISTRHO
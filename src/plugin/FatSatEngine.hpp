@@ -0,0 +1,163 @@
+/*
+ * FatSat Engine - Process-wide LibGodot engine shared by all editor windows
+ * Part of the Enlil/GodotVST Framework
+ *
+ * Booting Godot costs far more than opening a window, and users open and
+ * close plugin editors constantly. The engine host owns the library handle
+ * and the running Godot instance for the whole process: editors acquire it
+ * when they open and release it when they close. After the last editor
+ * closes, the engine (with its main scene loaded) is kept warm so that the
+ * next open only has to wait for a frame.
+ *
+ * A warm engine is shut down right away when the last editor closes if it
+ * uses more memory than the budget (or keeping it warm is off). Otherwise
+ * it is released once it has been idle longer than the idle timeout, and
+ * in any case when the host destroys the last plugin instance. Godot can
+ * only be torn down from the thread that created it, so the timeout is
+ * checked on the UI thread: on the next acquire() and whenever a plugin
+ * instance is destroyed (FatSatInstances.hpp). The static destructor never
+ * touches Godot; it may run on any thread, after the host closed its
+ * display.
+ *
+ * Open editors share the one engine: each gets an editor ID and its own
+ * FrameBridge, the Godot side (EditorSpawner) instantiates one editor scene
+ * per ID, and a single iteration() renders every editor's SubViewport.
+ *
+ * All methods must be called from the host's UI thread.
+ */
+
+#ifndef FATSAT_ENGINE_HPP
+#define FATSAT_ENGINE_HPP
+
+// GLX types for context management (must come before DPF headers)
+#include "FatSatGLContext.hpp"
+#include "FatSatLoader.hpp"
+#include "FatSatPck.hpp"
+
+#include <godot_cpp/classes/godot_instance.hpp>
+
+#include <cstdint>
+#include <vector>
+
+START_NAMESPACE_DISTRHO
+
+class GodotEngineHost {
+public:
+    enum Stage {
+        kStageIdle,
+        kStageLoadingLibrary,
+        kStageCreating,
+        kStageStarting,
+        kStageRunning,
+        kStageFailed
+    };
+
+    // Defaults, overridable with FATSAT_ENGINE_IDLE_TIMEOUT (seconds) and
+    // FATSAT_ENGINE_MEMORY_BUDGET (MiB) in the environment; 0 for either
+    // never keeps the engine warm
+    static constexpr uint32_t kDefaultIdleTimeoutSec = 300;
+    static constexpr uint32_t kDefaultMemoryBudgetMiB = 768;
+
+    // Default shortest interval between two iterations, however many
+    // editors drive the engine from their uiIdle()
+    static constexpr uint64_t kDefaultMinIterationIntervalNs = 15000000;
+
+    static GodotEngineHost& instance();
+
+    // Register an editor and open its FrameBridge; boots the engine if it
+    // is not warm. Returns the editor ID.
+    uint32_t acquire();
+
+    // Unregister an editor and close its FrameBridge; the engine stays
+    // warm unless over budget or keeping it warm is off
+    void release(uint32_t editorId);
+
+    // Advance a cold boot by one stage (call from uiIdle)
+    void advanceStartup();
+
+    // Run one engine frame for all editors (throttled, call from any uiIdle)
+    // Returns true if a frame was run
+    bool iterate();
+
+    Stage getStage() const { return fStage; }
+    bool isRunning() const { return fStage == kStageRunning; }
+    bool hasFailed() const { return fStage == kStageFailed; }
+    bool isUsingEmbeddedPck() const { return fUsingEmbeddedPck; }
+    size_t getEditorCount() const { return fEditors.size(); }
+
+    // Frames run since the process started; changes whenever any editor's
+    // uiIdle() rendered new frames for all of them
+    uint64_t getIterationCount() const { return fIterationCount; }
+
+    // Engine memory (static + video), 0 if not running
+    uint64_t getMemoryUsage() const;
+
+    // Off shuts the engine down whenever the last editor closes
+    void setKeepWarm(bool keepWarm) { fKeepWarm = keepWarm; }
+    void setIdleTimeout(uint32_t seconds) { fIdleTimeoutSec = seconds; }
+    void setMemoryBudget(uint32_t mebibytes) { fMemoryBudgetMiB = mebibytes; }
+
+    // 0 iterates on every call (offscreen benchmarks). Editors can ask for
+    // a longer interval through FrameBridge::setFrameInterval(); the
+    // longest request wins, since one frame renders every editor.
+    void setMinIterationInterval(uint64_t nanoseconds) { fMinIterationIntervalNs = nanoseconds; }
+
+    // Godot display driver ("x11", "wayland", ...) passed on the next cold
+    // boot; nullptr uses Godot's default. FATSAT_GODOT_DISPLAY_DRIVER in the
+    // environment takes precedence.
+    void setDisplayDriver(const char* driver) { fDisplayDriver = driver; }
+
+private:
+    GodotEngineHost();
+    ~GodotEngineHost();
+
+    bool initGodot();
+    void startGodot();
+    void shutdownGodot();
+    void unloadLibGodot();
+
+    // True for a warm engine without editors that sat idle past the timeout
+    bool isIdleExpired() const;
+
+    // PluginInstances destroy callback
+    static void pluginDestroyed(bool last);
+
+    // Editors currently using the engine
+    std::vector<uint32_t> fEditors;
+    uint32_t fNextEditorId;
+    uint64_t fLastIterationNs;
+    uint64_t fMinIterationIntervalNs;
+    uint64_t fIterationCount;
+
+    Stage fStage;
+    LibGodotLoader fLibGodotLoader;
+
+    // LibGodot library handle and function pointers (kept until the last plugin instance is destroyed)
+    void* fLibGodotHandle;
+    LibGodotCreateInstanceFunc fCreateInstance;
+    LibGodotDestroyInstanceFunc fDestroyInstance;
+
+    // Godot instance (using godot-cpp wrapper)
+    godot::GodotInstance* fGodotInstance;
+
+    // Godot project pack embedded in the binary (if built with one)
+    EmbeddedPck fEmbeddedPck;
+    bool fUsingEmbeddedPck;
+
+    // Warm engine limits
+    bool fKeepWarm;
+    uint32_t fIdleTimeoutSec;
+    uint32_t fMemoryBudgetMiB;
+    uint64_t fIdleSinceNs;
+
+    const char* fDisplayDriver;
+
+    // Godot's GL context - captured after start() so we can restore it
+    GodotGLContext fGodotContext;
+
+    DISTRHO_DECLARE_NON_COPYABLE(GodotEngineHost)
+};
+
+END_NAMESPACE_DISTRHO
+
+#endif // FATSAT_ENGINE_HPP
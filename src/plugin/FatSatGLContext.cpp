@@ -0,0 +1,124 @@
+/*
+ * FatSat GL Context - Godot's OpenGL context, GLX or EGL
+ * Part of the Enlil/GodotVST Framework
+ */
+
+#include "FatSatGLContext.hpp"
+
+#if defined(FATSAT_HAVE_EGL)
+#include <EGL/egl.h>
+#endif
+
+#include <cstdio>
+
+START_NAMESPACE_DISTRHO
+
+GodotGLContext::GodotGLContext()
+    : fApi(kApiNone),
+#if !defined(__APPLE__)
+      fGLXDisplay(nullptr),
+      fGLXDrawable(0),
+      fGLXContext(nullptr),
+#endif
+      fEGLDisplay(nullptr),
+      fEGLDrawSurface(nullptr),
+      fEGLReadSurface(nullptr),
+      fEGLContext(nullptr)
+{
+}
+
+bool GodotGLContext::captureCurrent()
+{
+    clear();
+
+#if !defined(__APPLE__)
+    if (GLXContext context = glXGetCurrentContext()) {
+        fGLXDisplay = glXGetCurrentDisplay();
+        fGLXDrawable = glXGetCurrentDrawable();
+        fGLXContext = context;
+        fApi = kApiGLX;
+    }
+#endif
+
+#if defined(FATSAT_HAVE_EGL)
+    if (fApi == kApiNone) {
+        EGLContext context = eglGetCurrentContext();
+        if (context != EGL_NO_CONTEXT) {
+            fEGLDisplay = eglGetCurrentDisplay();
+            fEGLDrawSurface = eglGetCurrentSurface(EGL_DRAW);
+            fEGLReadSurface = eglGetCurrentSurface(EGL_READ);
+            fEGLContext = context;
+            fApi = kApiEGL;
+        }
+    }
+#endif
+
+    if (fApi == kApiNone) {
+        fprintf(stderr, "[FatSat] No GL context current after Godot start\n");
+        return false;
+    }
+
+    fprintf(stdout, "[FatSat] Captured Godot %s context\n", getApiName());
+    return true;
+}
+
+void GodotGLContext::clear()
+{
+    fApi = kApiNone;
+#if !defined(__APPLE__)
+    fGLXDisplay = nullptr;
+    fGLXDrawable = 0;
+    fGLXContext = nullptr;
+#endif
+    fEGLDisplay = nullptr;
+    fEGLDrawSurface = nullptr;
+    fEGLReadSurface = nullptr;
+    fEGLContext = nullptr;
+}
+
+void GodotGLContext::makeCurrent() const
+{
+    switch (fApi) {
+#if !defined(__APPLE__)
+    case kApiGLX:
+        glXMakeCurrent(fGLXDisplay, fGLXDrawable, fGLXContext);
+        break;
+#endif
+#if defined(FATSAT_HAVE_EGL)
+    case kApiEGL:
+        eglMakeCurrent(fEGLDisplay, fEGLDrawSurface, fEGLReadSurface, fEGLContext);
+        break;
+#endif
+    default:
+        break;
+    }
+}
+
+void GodotGLContext::release() const
+{
+    switch (fApi) {
+#if !defined(__APPLE__)
+    case kApiGLX:
+        glXMakeCurrent(fGLXDisplay, None, nullptr);
+        break;
+#endif
+#if defined(FATSAT_HAVE_EGL)
+    case kApiEGL:
+        eglMakeCurrent(fEGLDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        break;
+#endif
+    default:
+        break;
+    }
+}
+
+const char* GodotGLContext::getApiName() const
+{
+    switch (fApi) {
+    case kApiGLX: return "GLX";
+    case kApiEGL: return "EGL";
+    default:      return "none";
+    }
+}
+
+END_NAMESPACE_DISTRHO
@@ -0,0 +1,75 @@
+/*
+ * FatSat GL Context - Godot's OpenGL context, GLX or EGL
+ * Part of the Enlil/GodotVST Framework
+ *
+ * Godot creates its GL context inside start() and leaves it current. The
+ * host's UI binds its own context between engine frames, so the engine has
+ * to make Godot's current again before every iteration(). On X11 that is a
+ * GLX context; with Godot's Wayland display driver (used for offscreen runs
+ * against a headless compositor) it is an EGL context. Whichever is current
+ * after start() is captured here.
+ *
+ * EGL support is compiled in when FATSAT_HAVE_EGL is defined (the plugin
+ * Makefile sets it when pkg-config finds egl).
+ */
+
+#ifndef FATSAT_GL_CONTEXT_HPP
+#define FATSAT_GL_CONTEXT_HPP
+
+// GLX types (must come before DPF headers)
+#if !defined(__APPLE__)
+#include <X11/Xlib.h>
+#include <GL/glx.h>
+#endif
+
+#include "DistrhoUtils.hpp"
+
+START_NAMESPACE_DISTRHO
+
+class GodotGLContext {
+public:
+    enum Api {
+        kApiNone,
+        kApiGLX,
+        kApiEGL
+    };
+
+    GodotGLContext();
+
+    // Capture the context current on this thread (call right after start())
+    // Returns false if no GLX or EGL context is current
+    bool captureCurrent();
+
+    // Forget the captured context (after the engine shut down)
+    void clear();
+
+    // Bind / unbind the captured context on this thread
+    void makeCurrent() const;
+    void release() const;
+
+    Api getApi() const { return fApi; }
+    bool isValid() const { return fApi != kApiNone; }
+    const char* getApiName() const;
+
+private:
+    Api fApi;
+
+#if !defined(__APPLE__)
+    Display* fGLXDisplay;
+    GLXDrawable fGLXDrawable;
+    GLXContext fGLXContext;
+#endif
+
+    // EGLDisplay / EGLSurface / EGLContext, kept opaque so this header does
+    // not pull in EGL's platform types
+    void* fEGLDisplay;
+    void* fEGLDrawSurface;
+    void* fEGLReadSurface;
+    void* fEGLContext;
+
+    DISTRHO_DECLARE_NON_COPYABLE(GodotGLContext)
+};
+
+END_NAMESPACE_DISTRHO
+
+#endif // FATSAT_GL_CONTEXT_HPP
@@ -0,0 +1,69 @@
+/*
+ * FatSat Instances - Process-wide count of live plugin instances
+ * Part of the Enlil/GodotVST Framework
+ *
+ * The warm Godot engine outlives its editors but not the plugin: once the
+ * host has destroyed every FatSatPlugin, nothing can open an editor again
+ * and the engine is shut down. The DSP code does not link against the
+ * engine (FatSatHost builds without it), so the engine host registers a
+ * callback here instead of the plugin calling into it.
+ *
+ * Hosts create and destroy plugin instances on their main thread, the one
+ * the editors run on, so the callback may tear Godot down directly.
+ */
+
+#ifndef FATSAT_INSTANCES_HPP
+#define FATSAT_INSTANCES_HPP
+
+#include "DistrhoUtils.hpp"
+
+#include <atomic>
+#include <cstdint>
+
+START_NAMESPACE_DISTRHO
+
+class PluginInstances {
+public:
+    // Called after each instance is destroyed; last is true when none are left
+    typedef void (*DestroyCallback)(bool last);
+
+    static void created()
+    {
+        count().fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void destroyed()
+    {
+        const bool last = count().fetch_sub(1, std::memory_order_acq_rel) == 1;
+        if (const DestroyCallback callback = destroyCallback().load(std::memory_order_acquire)) {
+            callback(last);
+        }
+    }
+
+    static uint32_t getCount()
+    {
+        return count().load(std::memory_order_relaxed);
+    }
+
+    static void setDestroyCallback(DestroyCallback callback)
+    {
+        destroyCallback().store(callback, std::memory_order_release);
+    }
+
+private:
+    static std::atomic<uint32_t>& count()
+    {
+        static std::atomic<uint32_t> sCount(0);
+        return sCount;
+    }
+
+    static std::atomic<DestroyCallback>& destroyCallback()
+    {
+        static std::atomic<DestroyCallback> sCallback(nullptr);
+        return sCallback;
+    }
+};
+
+END_NAMESPACE_DISTRHO
+
+#endif // FATSAT_INSTANCES_HPP
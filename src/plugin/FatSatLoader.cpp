@@ -0,0 +1,223 @@
+/*
+ * FatSat Loader - Background loading of the LibGodot shared library
+ * Part of the Enlil/GodotVST Framework
+ */
+
+#include "FatSatLoader.hpp"
+#include "../shared/frame_bridge.hpp"
+
+#include <dlfcn.h>
+#include <cstdio>
+#include <mutex>
+
+#if defined(FATSAT_STATIC_LIBGODOT)
+// Provided by the static LibGodot archive (core/extension/libgodot.h)
+extern "C" {
+GDExtensionObjectPtr libgodot_create_godot_instance(int p_argc, char* p_argv[],
+                                                    GDExtensionInitializationFunction p_init_func);
+void libgodot_destroy_godot_instance(GDExtensionObjectPtr p_godot_instance);
+}
+#endif
+
+START_NAMESPACE_DISTRHO
+
+// State shared between the UI and the worker thread. The worker holds its
+// own reference, so a cancelled load can finish after the UI let go of it.
+struct LibGodotLoader::Shared {
+    mutable std::mutex lock;
+    State state = kStateIdle;
+    bool cancelled = false;
+
+    void* handle = nullptr;
+    LibGodotCreateInstanceFunc createInstance = nullptr;
+    LibGodotDestroyInstanceFunc destroyInstance = nullptr;
+
+    double loadTimeMs = 0.0;
+};
+
+#if !defined(FATSAT_STATIC_LIBGODOT)
+// Runs on the worker thread
+static void loadLibrary(void*& handle,
+                        LibGodotCreateInstanceFunc& createInstance,
+                        LibGodotDestroyInstanceFunc& destroyInstance)
+{
+    // Try to find libgodot.so in various locations
+    const char* paths[] = {
+        // Relative to plugin location
+        "./libgodot.linuxbsd.template_release.x86_64.so",
+        "../lib/libgodot.linuxbsd.template_release.x86_64.so",
+        // From build output
+        "godot/bin/libgodot.linuxbsd.template_release.x86_64.so",
+        // Symlink name
+        "./libgodot.so",
+        nullptr
+    };
+
+    for (int i = 0; paths[i] != nullptr; ++i) {
+        handle = dlopen(paths[i], RTLD_NOW | RTLD_LOCAL);
+        if (handle) {
+            fprintf(stdout, "[FatSat] Loaded LibGodot from: %s\n", paths[i]);
+            break;
+        }
+    }
+
+    if (!handle) {
+        // Try with just the library name (system search)
+        handle = dlopen("libgodot.linuxbsd.template_release.x86_64.so", RTLD_NOW | RTLD_LOCAL);
+    }
+
+    if (!handle) {
+        fprintf(stderr, "[FatSat] Failed to load LibGodot: %s\n", dlerror());
+        return;
+    }
+
+    // Get function pointers
+    *(void**)(&createInstance) = dlsym(handle, "libgodot_create_godot_instance");
+    *(void**)(&destroyInstance) = dlsym(handle, "libgodot_destroy_godot_instance");
+
+    if (!createInstance || !destroyInstance) {
+        fprintf(stderr, "[FatSat] Failed to get LibGodot symbols: create=%p destroy=%p\n",
+                (void*)createInstance, (void*)destroyInstance);
+        dlclose(handle);
+        handle = nullptr;
+        createInstance = nullptr;
+        destroyInstance = nullptr;
+        return;
+    }
+
+    fprintf(stdout, "[FatSat] LibGodot symbols loaded successfully\n");
+}
+#endif
+
+LibGodotLoader::LibGodotLoader()
+    : fShared(std::make_shared<Shared>())
+{
+}
+
+LibGodotLoader::~LibGodotLoader()
+{
+    cancel();
+    wait();
+}
+
+void LibGodotLoader::start()
+{
+#if defined(FATSAT_STATIC_LIBGODOT)
+    // Nothing to load or relocate, the entry points are link-time symbols
+    std::lock_guard<std::mutex> guard(fShared->lock);
+    if (!fShared->cancelled && fShared->state != kStateReady) {
+        fShared->createInstance = libgodot_create_godot_instance;
+        fShared->destroyInstance = libgodot_destroy_godot_instance;
+        fShared->state = kStateReady;
+    }
+#else
+    {
+        std::lock_guard<std::mutex> guard(fShared->lock);
+        // A failed load may be retried
+        if (fShared->cancelled || fShared->state == kStateLoading || fShared->state == kStateReady) {
+            return;
+        }
+        fShared->state = kStateLoading;
+    }
+
+    // The worker of a failed load has finished
+    wait();
+
+    std::shared_ptr<Shared> shared = fShared;
+
+    fWorker = std::thread([shared]() {
+        void* handle = nullptr;
+        LibGodotCreateInstanceFunc createInstance = nullptr;
+        LibGodotDestroyInstanceFunc destroyInstance = nullptr;
+
+        const uint64_t start = enlil::hostTimeNs();
+        loadLibrary(handle, createInstance, destroyInstance);
+        const double elapsedMs = (enlil::hostTimeNs() - start) / 1.0e6;
+
+        std::lock_guard<std::mutex> guard(shared->lock);
+        shared->loadTimeMs = elapsedMs;
+
+        if (shared->cancelled) {
+            // The window was closed while loading, nobody will take it
+            if (handle) {
+                dlclose(handle);
+            }
+            shared->state = kStateIdle;
+            return;
+        }
+
+        shared->handle = handle;
+        shared->createInstance = createInstance;
+        shared->destroyInstance = destroyInstance;
+        shared->state = handle ? kStateReady : kStateFailed;
+    });
+#endif
+}
+
+void LibGodotLoader::wait()
+{
+    if (fWorker.joinable()) {
+        fWorker.join();
+    }
+}
+
+LibGodotLoader::State LibGodotLoader::getState() const
+{
+    std::lock_guard<std::mutex> guard(fShared->lock);
+    return fShared->state;
+}
+
+bool LibGodotLoader::take(void*& handle,
+                          LibGodotCreateInstanceFunc& createInstance,
+                          LibGodotDestroyInstanceFunc& destroyInstance)
+{
+    std::lock_guard<std::mutex> guard(fShared->lock);
+    if (fShared->state != kStateReady) {
+        return false;
+    }
+
+    handle = fShared->handle;
+    createInstance = fShared->createInstance;
+    destroyInstance = fShared->destroyInstance;
+
+    fShared->handle = nullptr;
+    fShared->createInstance = nullptr;
+    fShared->destroyInstance = nullptr;
+    fShared->state = kStateIdle;
+    return true;
+}
+
+void LibGodotLoader::cancel()
+{
+    std::lock_guard<std::mutex> guard(fShared->lock);
+    fShared->cancelled = true;
+
+    // Loaded but never taken
+    if (fShared->handle) {
+        dlclose(fShared->handle);
+        fShared->handle = nullptr;
+        fShared->createInstance = nullptr;
+        fShared->destroyInstance = nullptr;
+    }
+
+    if (fShared->state != kStateLoading) {
+        fShared->state = kStateIdle;
+    }
+}
+
+double LibGodotLoader::getLoadTimeMs() const
+{
+    std::lock_guard<std::mutex> guard(fShared->lock);
+    return fShared->loadTimeMs;
+}
+
+bool LibGodotLoader::isStaticallyLinked()
+{
+#if defined(FATSAT_STATIC_LIBGODOT)
+    return true;
+#else
+    return false;
+#endif
+}
+
+END_NAMESPACE_DISTRHO
@@ -0,0 +1,90 @@
+/*
+ * FatSat Loader - Background loading of the LibGodot shared library
+ * Part of the Enlil/GodotVST Framework
+ *
+ * dlopen() of LibGodot resolves a multi-MB library eagerly (RTLD_NOW) and
+ * runs its static constructors. The loader does this on a worker thread so
+ * the host's UI thread never blocks while the editor opens. The UI polls the
+ * loader from uiIdle() and takes ownership of the handle once it is ready.
+ *
+ * The worker runs code from the plugin binary, so it must not outlive it:
+ * wait() (also called by the destructor) joins it. Do that before the host
+ * can unload the binary, not from a static destructor, which may run while
+ * dlclose() holds the loader lock the worker's dlopen() needs.
+ *
+ * The engine itself is still created on the UI thread: Godot binds its main
+ * thread and GL context to the thread that runs setup, and that must be the
+ * thread that later calls iteration().
+ *
+ * With FATSAT_STATIC_LIBGODOT, LibGodot is linked into the UI binary and
+ * the loader is ready immediately without starting a thread.
+ */
+
+#ifndef FATSAT_LOADER_HPP
+#define FATSAT_LOADER_HPP
+
+#include "DistrhoUtils.hpp"
+
+#include <gdextension_interface.h>
+
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+START_NAMESPACE_DISTRHO
+
+// LibGodot API function pointer types (simplified 3-arg signature)
+typedef GDExtensionObjectPtr (*LibGodotCreateInstanceFunc)(
+    int p_argc, char* p_argv[],
+    GDExtensionInitializationFunction p_init_func
+);
+typedef void (*LibGodotDestroyInstanceFunc)(GDExtensionObjectPtr p_godot_instance);
+
+class LibGodotLoader {
+public:
+    enum State {
+        kStateIdle,
+        kStateLoading,
+        kStateReady,
+        kStateFailed
+    };
+
+    LibGodotLoader();
+    ~LibGodotLoader();
+
+    // Start loading on a worker thread (no-op while loading or ready)
+    void start();
+
+    // Current state, never blocks on the worker
+    State getState() const;
+
+    // Transfer the loaded library to the caller (only in kStateReady)
+    // The caller becomes responsible for dlclose()
+    bool take(void*& handle,
+              LibGodotCreateInstanceFunc& createInstance,
+              LibGodotDestroyInstanceFunc& destroyInstance);
+
+    // Abandon the load; if it is still running, the worker closes the
+    // library itself when it finishes
+    void cancel();
+
+    // Block until a running load has finished
+    void wait();
+
+    // Time spent in dlopen/dlsym on the worker thread
+    double getLoadTimeMs() const;
+
+    // True when LibGodot is linked statically instead of dlopen'ed
+    static bool isStaticallyLinked();
+
+private:
+    struct Shared;
+    std::shared_ptr<Shared> fShared;
+    std::thread fWorker;
+
+    DISTRHO_DECLARE_NON_COPYABLE(LibGodotLoader)
+};
+
+END_NAMESPACE_DISTRHO
+
+#endif // FATSAT_LOADER_HPP
@@ -0,0 +1,131 @@
+/*
+ * FatSat PCK - Godot project pack embedded in the plugin binary
+ * Part of the Enlil/GodotVST Framework
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "FatSatPck.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// FATSAT_PCK_PATH is set by the plugin Makefile when build/godot/fatsat.pck exists
+#if defined(FATSAT_EMBED_PCK) && defined(__linux__)
+#define FATSAT_HAS_EMBEDDED_PCK 1
+
+__asm__(
+    ".section .rodata.fatsat_pck,\"a\",@progbits\n"
+    ".balign 64\n"
+    ".hidden fatsat_pck_begin\n"
+    ".hidden fatsat_pck_end\n"
+    ".global fatsat_pck_begin\n"
+    ".global fatsat_pck_end\n"
+    "fatsat_pck_begin:\n"
+    ".incbin \"" FATSAT_PCK_PATH "\"\n"
+    "fatsat_pck_end:\n"
+    ".previous\n"
+);
+
+extern "C" const uint8_t fatsat_pck_begin[];
+extern "C" const uint8_t fatsat_pck_end[];
+#endif
+
+START_NAMESPACE_DISTRHO
+
+EmbeddedPck::EmbeddedPck()
+    : fFd(-1)
+{
+    fPath[0] = '\0';
+}
+
+EmbeddedPck::~EmbeddedPck()
+{
+    close();
+}
+
+bool EmbeddedPck::isAvailable()
+{
+    return getSize() > 0;
+}
+
+const uint8_t* EmbeddedPck::getData()
+{
+#if defined(FATSAT_HAS_EMBEDDED_PCK)
+    return fatsat_pck_begin;
+#else
+    return nullptr;
+#endif
+}
+
+size_t EmbeddedPck::getSize()
+{
+#if defined(FATSAT_HAS_EMBEDDED_PCK)
+    return static_cast<size_t>(fatsat_pck_end - fatsat_pck_begin);
+#else
+    return 0;
+#endif
+}
+
+const char* EmbeddedPck::open()
+{
+    if (fFd >= 0) {
+        return fPath;
+    }
+
+#if defined(FATSAT_HAS_EMBEDDED_PCK)
+    const uint8_t* data = getData();
+    size_t remaining = getSize();
+
+    // Anonymous memory file; Godot opens it through /proc/self/fd
+    fFd = memfd_create("fatsat.pck", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fFd < 0) {
+        fprintf(stderr, "[FatSat] memfd_create failed: %s\n", strerror(errno));
+        return nullptr;
+    }
+
+    while (remaining > 0) {
+        const ssize_t written = write(fFd, data, remaining);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            fprintf(stderr, "[FatSat] Failed to write embedded PCK: %s\n", strerror(errno));
+            close();
+            return nullptr;
+        }
+        data += written;
+        remaining -= static_cast<size_t>(written);
+    }
+
+    // The pack is read-only from here on
+    fcntl(fFd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL);
+
+    snprintf(fPath, sizeof(fPath), "/proc/self/fd/%d", fFd);
+    return fPath;
+#else
+    return nullptr;
+#endif
+}
+
+void EmbeddedPck::close()
+{
+#if defined(__linux__)
+    if (fFd >= 0) {
+        ::close(fFd);
+    }
+#endif
+    fFd = -1;
+    fPath[0] = '\0';
+}
+
+END_NAMESPACE_DISTRHO
@@ -0,0 +1,48 @@
+/*
+ * FatSat PCK - Godot project pack embedded in the plugin binary
+ * Part of the Enlil/GodotVST Framework
+ *
+ * The Godot project is exported to a PCK at build time (make pck) and
+ * linked into the UI binary as a read-only section. At startup the pack is
+ * exposed to LibGodot as a sealed in-memory file, so Godot never parses the
+ * loose project directory and does not depend on the host's working directory.
+ */
+
+#ifndef FATSAT_PCK_HPP
+#define FATSAT_PCK_HPP
+
+#include "DistrhoUtils.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+START_NAMESPACE_DISTRHO
+
+class EmbeddedPck {
+public:
+    EmbeddedPck();
+    ~EmbeddedPck();
+
+    // True if the binary was built with an embedded pack
+    static bool isAvailable();
+
+    // Embedded pack data (nullptr when not available)
+    static const uint8_t* getData();
+    static size_t getSize();
+
+    // Expose the pack as an in-memory file
+    // Returns a path for --main-pack, or nullptr on failure
+    // The path stays valid until close() (Godot reopens it for every resource)
+    const char* open();
+    void close();
+
+private:
+    int fFd;
+    char fPath[64];
+
+    DISTRHO_DECLARE_NON_COPYABLE(EmbeddedPck)
+};
+
+END_NAMESPACE_DISTRHO
+
+#endif // FATSAT_PCK_HPP
@@ -4,19 +4,50 @@
  */
 
 #include "FatSatPlugin.hpp"
+#include "FatSatInstances.hpp"
 #include <cmath>
+#include <cstdio>
+#include <cstring>
 #include <algorithm>
 
 // Shared DSP-UI bridge for visualization data
 #include "../shared/dsp_bridge.hpp"
+#include "../shared/session_log.hpp"
+#include "../shared/trace.hpp"
 
 START_NAMESPACE_DISTRHO
 
 FatSatPlugin::FatSatPlugin()
-    : Plugin(kParamCount, 0, 1), // params, programs, states
+    : Plugin(kParamCount, 0, kStateCount), // params, programs, states
       fFatness(0.0f),
-      fOutput(1.0f)
+      fOutput(1.0f),
+      fQuality(kQualityAuto),
+      fQueuedFatness(0.0f),
+      fQueuedOutput(1.0f),
+      fDspFatness(0.0f),
+      fDspOutput(1.0f),
+      fSeenProcessOverruns(0),
+      fActiveTier(enlil::DSP_TIER_NORMAL),
+      fRecordSession(enlil::SessionRecorder::instance().claim(enlil::SESSION_SOURCE_DSP, this))
 {
+    fLoadMeter.setSampleRate(getSampleRate());
+    fLimiter.setSampleRate(getSampleRate());
+
+    // Every quality tier has the oversampler's latency, plus the limiter's
+    // lookahead
+    setLatency(enlil::Saturator::kLatency + fLimiter.getLatency());
+
+    PluginInstances::created();
+}
+
+FatSatPlugin::~FatSatPlugin()
+{
+    if (fRecordSession) {
+        enlil::SessionRecorder::instance().unclaim(enlil::SESSION_SOURCE_DSP, this);
+    }
+
+    // Lets the engine host shut a warm engine down (see FatSatInstances.hpp)
+    PluginInstances::destroyed();
 }
 
 void FatSatPlugin::initParameter(uint32_t index, Parameter& parameter)
@@ -41,6 +72,67 @@ void FatSatPlugin::initParameter(uint32_t index, Parameter& parameter)
         parameter.ranges.min = 0.0f;
         parameter.ranges.max = 1.0f;
         break;
+
+    case kParamDspLoad:
+        parameter.hints = kParameterIsOutput;
+        parameter.name = "DSP Load";
+        parameter.symbol = "dsp_load";
+        parameter.unit = "%";
+        parameter.ranges.def = 0.0f;
+        parameter.ranges.min = 0.0f;
+        parameter.ranges.max = 100.0f;
+        break;
+
+    case kParamDspLoadPeak:
+        parameter.hints = kParameterIsOutput;
+        parameter.name = "DSP Load Peak";
+        parameter.symbol = "dsp_load_peak";
+        parameter.unit = "%";
+        parameter.ranges.def = 0.0f;
+        parameter.ranges.min = 0.0f;
+        parameter.ranges.max = 100.0f;
+        break;
+
+    case kParamDspOverruns:
+        parameter.hints = kParameterIsOutput | kParameterIsInteger;
+        parameter.name = "DSP Overruns";
+        parameter.symbol = "dsp_overruns";
+        parameter.ranges.def = 0.0f;
+        parameter.ranges.min = 0.0f;
+        parameter.ranges.max = 1000000.0f;
+        break;
+
+    case kParamQuality:
+        parameter.hints = kParameterIsInteger;
+        parameter.name = "Quality";
+        parameter.symbol = "quality";
+        parameter.ranges.def = kQualityAuto;
+        parameter.ranges.min = kQualityAuto;
+        parameter.ranges.max = kQualityHQ;
+        parameter.enumValues.count = 4;
+        parameter.enumValues.restrictedMode = true;
+        {
+            ParameterEnumerationValue* const values = new ParameterEnumerationValue[4];
+            values[0].label = "Auto";
+            values[0].value = kQualityAuto;
+            values[1].label = "Eco";
+            values[1].value = kQualityEco;
+            values[2].label = "Normal";
+            values[2].value = kQualityNormal;
+            values[3].label = "HQ";
+            values[3].value = kQualityHQ;
+            parameter.enumValues.values = values;
+        }
+        break;
+
+    case kParamQualityActive:
+        parameter.hints = kParameterIsOutput | kParameterIsInteger;
+        parameter.name = "Quality In Use";
+        parameter.symbol = "quality_active";
+        parameter.ranges.def = enlil::DSP_TIER_NORMAL;
+        parameter.ranges.min = enlil::DSP_TIER_ECO;
+        parameter.ranges.max = enlil::DSP_TIER_HQ;
+        break;
     }
 }
 
@@ -48,83 +140,263 @@ float FatSatPlugin::getParameterValue(uint32_t index) const
 {
     switch (index) {
     case kParamFatness:
-        return fFatness;
+        return fFatness.load(std::memory_order_relaxed);
     case kParamOutput:
-        return fOutput;
+        return fOutput.load(std::memory_order_relaxed);
+    case kParamDspLoad:
+        return std::min(fLoadMeter.getLoad(), 100.0f);
+    case kParamDspLoadPeak:
+        return std::min(fLoadMeter.getMaxLoad(), 100.0f);
+    case kParamDspOverruns:
+        return static_cast<float>(std::min<uint64_t>(fLoadMeter.getOverrunCount(), 1000000));
+    case kParamQuality:
+        return static_cast<float>(fQuality.load(std::memory_order_relaxed));
+    case kParamQualityActive:
+        return static_cast<float>(fActiveTier.load(std::memory_order_relaxed));
     default:
         return 0.0f;
     }
 }
 
 void FatSatPlugin::setParameterValue(uint32_t index, float value)
+{
+    if (fRecordSession) {
+        enlil::SessionRecorder::instance().recordParameter(index, value);
+    }
+
+    // Any thread: only the values change here, run() queues them
+    switch (index) {
+    case kParamFatness:
+        fFatness.store(value, std::memory_order_relaxed);
+        break;
+    case kParamOutput:
+        fOutput.store(value, std::memory_order_relaxed);
+        break;
+    case kParamQuality:
+        fQuality.store(qualityFor(value), std::memory_order_relaxed);
+        break;
+    }
+}
+
+void FatSatPlugin::setParameterValueAtFrame(uint32_t index, float value, uint32_t frame)
 {
     switch (index) {
     case kParamFatness:
-        fFatness = value;
+        fFatness.store(value, std::memory_order_relaxed);
+        fQueuedFatness = value;
+        fEvents.push(frame, index, value);
         break;
     case kParamOutput:
-        fOutput = value;
+        fOutput.store(value, std::memory_order_relaxed);
+        fQueuedOutput = value;
+        fEvents.push(frame, index, value);
+        break;
+    case kParamQuality:
+        fQuality.store(qualityFor(value), std::memory_order_relaxed);
         break;
     }
 }
 
+void FatSatPlugin::queueParameterChanges()
+{
+    const float fatness = fFatness.load(std::memory_order_relaxed);
+    if (fatness != fQueuedFatness) {
+        fQueuedFatness = fatness;
+        fEvents.push(decltype(fEvents)::kEndOfBlock, kParamFatness, fatness);
+    }
+    const float output = fOutput.load(std::memory_order_relaxed);
+    if (output != fQueuedOutput) {
+        fQueuedOutput = output;
+        fEvents.push(decltype(fEvents)::kEndOfBlock, kParamOutput, output);
+    }
+}
+
+void FatSatPlugin::activate()
+{
+    fLoadMeter.setSampleRate(getSampleRate());
+
+    // Start from the current values instead of ramping from the last run
+    fEvents.clear();
+    fDspFatness = fQueuedFatness = fFatness.load(std::memory_order_relaxed);
+    fDspOutput = fQueuedOutput = fOutput.load(std::memory_order_relaxed);
+    for (enlil::Saturator& saturator : fSaturators) {
+        saturator.reset(driveFor(fDspFatness), gainFor(fDspFatness, fDspOutput));
+    }
+    fTierSelector.reset(fSaturators[0].getTier());
+    fSeenProcessOverruns = enlil::DSPLoadMeter::getProcessOverrunCount();
+
+    // The lookahead is fixed in time, so the latency follows the rate
+    fLimiter.setSampleRate(getSampleRate());
+    setLatency(enlil::Saturator::kLatency + fLimiter.getLatency());
+}
+
+void FatSatPlugin::deactivate()
+{
+    // run() holds no curve until it is called again; the saturators must
+    // not point at one the next setState() may free
+    for (enlil::Saturator& saturator : fSaturators) {
+        saturator.setCurve(nullptr);
+    }
+    fCurveChannel.release();
+}
+
+void FatSatPlugin::sampleRateChanged(double newSampleRate)
+{
+    fLoadMeter.setSampleRate(newSampleRate);
+    fLimiter.setSampleRate(newSampleRate);
+    setLatency(enlil::Saturator::kLatency + fLimiter.getLatency());
+}
+
 void FatSatPlugin::initState(uint32_t index, State& state)
 {
-    if (index == 0) {
+    switch (index) {
+    case kStateBridge:
         state.key = "bridge_state";
         state.defaultValue = "";
+        break;
+    case kStateCurve:
+        state.key = "curve";
+        state.defaultValue = "";
+        break;
     }
 }
 
 void FatSatPlugin::setState(const char* key, const char* value)
 {
-    (void)key;
-    (void)value;
+    if (std::strcmp(key, "curve") == 0) {
+        setCurve(value);
+    }
+}
+
+void FatSatPlugin::setCurve(const char* text)
+{
+    if (text[0] == '\0') {
+        fCurveChannel.publish(nullptr);
+        return;
+    }
+
+    enlil::CurvePoint points[enlil::CurveTable::kMaxPoints];
+    uint32_t count = 0;
+    if (!enlil::CurveTable::parse(text, points, count)) {
+        fprintf(stderr, "[FatSat] Ignoring malformed curve state\n");
+        return;
+    }
+
+    // Instances on the same curve (presets, duplicated tracks) share one
+    // table, identified by its points
+    const size_t pointBytes = count * sizeof(enlil::CurvePoint);
+    const enlil::DSPTableKey key = {enlil::DSP_TABLE_CURVE, 1, enlil::CurveTable::kSize, 0.0,
+                                    enlil::hashTableContent(points, pointBytes)};
+    CurveTableRef table = enlil::DSPTableCache::instance().acquire<enlil::CurveTable>(
+        key, points, pointBytes, [&](enlil::CurveTable& curve) { curve.build(points, count); });
+
+    enlil::Blob* blob = fCurveChannel.create<CurveTableRef>(std::move(table));
+    if (!blob) {
+        fprintf(stderr, "[FatSat] Out of memory for the curve table\n");
+        return;
+    }
+
+    // References the audio thread has moved past are dropped here as well
+    fCurveChannel.publish(blob);
 }
 
 void FatSatPlugin::run(const float** inputs, float** outputs, uint32_t frames)
 {
-    const float* inL = inputs[0];
-    const float* inR = inputs[1];
+    ENLIL_TRACE_THREAD("audio");
+    ENLIL_TRACE_SCOPE("FatSatPlugin::run");
+
+    if (fRecordSession) {
+        enlil::SessionRecorder::instance().recordAudio(inputs, DISTRHO_PLUGIN_NUM_INPUTS, frames, getSampleRate());
+    }
+
+    const uint64_t loadStart = fLoadMeter.begin();
+
     float* outL = outputs[0];
     float* outR = outputs[1];
 
-    // Drive amount from fatness parameter (1.0 to 10.0)
-    const float drive = 1.0f + fFatness * 9.0f;
-    // Output gain with auto-compensation
-    const float gain = fOutput * (1.0f / (1.0f + fFatness * 0.5f));
-    // Ceiling limit at -0.1dB
-    const float ceiling = 0.989f;
+    // Tier for this block: fixed, or what Auto picked from the last blocks.
+    // The saturators crossfade into a new tier over the next few blocks.
+    const uint32_t quality = fQuality.load(std::memory_order_relaxed);
+    const enlil::DSPTier tier = quality == kQualityAuto
+        ? fTierSelector.getTier()
+        : static_cast<enlil::DSPTier>(quality - kQualityEco);
 
-    for (uint32_t i = 0; i < frames; ++i) {
-        // Tanh soft clipper: output = tanh(input * drive)
-        float sampleL = std::tanh(inL[i] * drive) * gain;
-        float sampleR = std::tanh(inR[i] * drive) * gain;
+    // Latest drawn curve; the reference used before is held until the
+    // next setState() sees this block has moved past it. acquire() gives up
+    // the previous table, so the saturators switch before setTier() primes
+    // the new tier with the curve.
+    const enlil::Blob* curve = fCurveChannel.acquire();
+
+    for (enlil::Saturator& saturator : fSaturators) {
+        saturator.setCurve(curve ? curve->as<CurveTableRef>()->get() : nullptr);
+        saturator.setTier(tier);
+    }
+
+    // Inter-sample peaks are worth the detector cost above Eco
+    fLimiter.setTruePeak(tier != enlil::DSP_TIER_ECO);
+
+    // Split the block at automation points; every sub-block ramps drive
+    // and gain to the values at its end, computed once per sub-block.
+    // Points without an offset end the block. An empty block still lands
+    // on its points: wrappers only resend a parameter when it changes.
+    queueParameterChanges();
+    const float startValues[2] = { fDspFatness, fDspOutput };
+    enlil::ParameterSplitter<kMaxParameterEvents, 2> splitter(fEvents, frames, startValues);
 
-        // Hard ceiling limiter
-        sampleL = std::fmax(-ceiling, std::fmin(ceiling, sampleL));
-        sampleR = std::fmax(-ceiling, std::fmin(ceiling, sampleR));
+    uint32_t start, end;
+    while (splitter.next(start, end)) {
+        // Drive amount from fatness parameter (1.0 to 10.0)
+        const float drive = driveFor(splitter.getValue(kParamFatness));
+        // Output gain with auto-compensation
+        const float gain = gainFor(splitter.getValue(kParamFatness), splitter.getValue(kParamOutput));
 
-        outL[i] = sampleL;
-        outR[i] = sampleR;
+        // Tanh soft clipper: output = tanh(input * drive)
+        for (uint32_t channel = 0; channel < DISTRHO_PLUGIN_NUM_OUTPUTS; ++channel) {
+            fSaturators[channel].process(inputs[channel] + start, outputs[channel] + start,
+                                         end - start, drive, gain);
+        }
     }
 
-    // Calculate RMS and peak for visualization
-    float sumL = 0.0f, sumR = 0.0f;
-    float peakL = 0.0f, peakR = 0.0f;
+    fDspFatness = splitter.getValue(kParamFatness);
+    fDspOutput = splitter.getValue(kParamOutput);
+    fEvents.clear();
+
+    // Lookahead ceiling limiter at -0.1dB
+    fLimiter.process(outputs, DISTRHO_PLUGIN_NUM_OUTPUTS, frames);
+
+    // Calculate RMS and peak for visualization (an empty block has none)
+    if (frames > 0) {
+        float sumL = 0.0f, sumR = 0.0f;
+        float peakL = 0.0f, peakR = 0.0f;
 
-    for (uint32_t i = 0; i < frames; ++i) {
-        sumL += outL[i] * outL[i];
-        sumR += outR[i] * outR[i];
-        peakL = std::max(peakL, std::fabs(outL[i]));
-        peakR = std::max(peakR, std::fabs(outR[i]));
+        for (uint32_t i = 0; i < frames; ++i) {
+            sumL += outL[i] * outL[i];
+            sumR += outR[i] * outR[i];
+            peakL = std::max(peakL, std::fabs(outL[i]));
+            peakR = std::max(peakR, std::fabs(outR[i]));
+        }
+
+        float rmsL = std::sqrt(sumL / frames);
+        float rmsR = std::sqrt(sumR / frames);
+
+        // Push to shared bridge for UI
+        enlil::DSPBridge::instance().pushVisualization(rmsL, rmsR, peakL, peakR);
     }
 
-    float rmsL = std::sqrt(sumL / frames);
-    float rmsR = std::sqrt(sumR / frames);
+    fLoadMeter.end(loadStart, frames);
+
+    // Any overrun in the process counts: instances share the cores
+    const uint64_t processOverruns = enlil::DSPLoadMeter::getProcessOverrunCount();
+    const bool overrun = processOverruns != fSeenProcessOverruns;
+    fSeenProcessOverruns = processOverruns;
+
+    if (quality == kQualityAuto) {
+        fTierSelector.update(fLoadMeter.getBlockLoad(), overrun, frames, getSampleRate());
+    } else {
+        fTierSelector.reset(tier);
+    }
 
-    // Push to shared bridge for UI
-    enlil::DSPBridge::instance().pushVisualization(rmsL, rmsR, peakL, peakR);
+    fActiveTier.store(fSaturators[0].getTier(), std::memory_order_relaxed);
 }
 
 Plugin* createPlugin()
@@ -8,17 +8,54 @@
 
 #include "DistrhoPlugin.hpp"
 
+#include "../shared/blob_channel.hpp"
+#include "../shared/dsp_load.hpp"
+#include "../shared/limiter.hpp"
+#include "../shared/param_events.hpp"
+#include "../shared/saturator.hpp"
+#include "../shared/table_cache.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
 START_NAMESPACE_DISTRHO
 
 enum Parameters {
     kParamFatness = 0,
     kParamOutput,
+    kParamDspLoad,      // Output: average load of run() in % of the block budget
+    kParamDspLoadPeak,  // Output: worst block in the last window, %
+    kParamDspOverruns,  // Output: blocks that exceeded their budget
+    kParamQuality,      // Auto, Eco, Normal, HQ
+    kParamQualityActive,// Output: tier in use (Eco, Normal, HQ)
     kParamCount
 };
 
+enum States {
+    kStateBridge = 0,
+    kStateCurve,        // Drawn saturation curve, CurveTable text ("" = tanh)
+    kStateCount
+};
+
+// Values of kParamQuality
+enum Quality {
+    kQualityAuto = 0,
+    kQualityEco,
+    kQualityNormal,
+    kQualityHQ
+};
+
 class FatSatPlugin : public Plugin {
 public:
     FatSatPlugin();
+    ~FatSatPlugin() override;
+
+    // Parameter change at a frame offset into the next run() block, for
+    // hosts and wrappers that know it (sample-accurate automation). Audio
+    // thread only, between run() calls; setParameterValue() changes may
+    // come from any thread and ramp across the whole block
+    void setParameterValueAtFrame(uint32_t index, float value, uint32_t frame);
 
 protected:
     const char* getLabel() const override { return "FatSat"; }
@@ -40,11 +77,64 @@ protected:
     void initState(uint32_t index, State& state) override;
     void setState(const char* key, const char* value) override;
 
+    void activate() override;
+    void deactivate() override;
+    void sampleRateChanged(double newSampleRate) override;
+
     void run(const float** inputs, float** outputs, uint32_t frames) override;
 
 private:
-    float fFatness;
-    float fOutput;
+    // Automation points queued for one block
+    static constexpr size_t kMaxParameterEvents = 64;
+
+    static float driveFor(float fatness) { return 1.0f + fatness * 9.0f; }
+    static float gainFor(float fatness, float output) { return output / (1.0f + fatness * 0.5f); }
+    static uint32_t qualityFor(float value) {
+        return std::min(static_cast<uint32_t>(std::max(value, 0.0f) + 0.5f),
+                        static_cast<uint32_t>(kQualityHQ));
+    }
+
+    // Queue host and UI changes run() has not seen yet as end-of-block points
+    void queueParameterChanges();
+
+    // Build the curve table from its text form and hand it to run()
+    void setCurve(const char* text);
+
+    // Current values, set from any thread (DPF wrappers forward UI edits
+    // from the UI thread)
+    std::atomic<float> fFatness;
+    std::atomic<float> fOutput;
+    std::atomic<uint32_t> fQuality;
+
+    // Automation for the next block (audio thread), the values last queued
+    // into it, and the values the DSP has reached
+    enlil::ParameterEventQueue<kMaxParameterEvents> fEvents;
+    float fQueuedFatness;
+    float fQueuedOutput;
+    float fDspFatness;
+    float fDspOutput;
+
+    // Waveshaper per channel, and the tier picker for kQualityAuto
+    enlil::Saturator fSaturators[DISTRHO_PLUGIN_NUM_OUTPUTS];
+    enlil::DSPTierSelector fTierSelector;
+    uint64_t fSeenProcessOverruns;
+
+    // Tier the saturators run, published by run() for kParamQualityActive
+    std::atomic<uint32_t> fActiveTier;
+
+    // Drawn curve tables, shared through the DSPTableCache: setState()
+    // publishes a reference, run() picks it up
+    using CurveTableRef = std::shared_ptr<const enlil::CurveTable>;
+    enlil::BlobChannel fCurveChannel;
+
+    // Stereo-linked lookahead ceiling after the saturators
+    enlil::LookaheadLimiter fLimiter;
+
+    // Wall time of run() against the real-time budget, per instance
+    enlil::DSPLoadMeter fLoadMeter;
+
+    // This instance feeds the session log (FATSAT_RECORD_SESSION)
+    bool fRecordSession;
 
     DISTRHO_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FatSatPlugin)
 };
@@ -13,15 +13,15 @@
 #endif
 
 #include "FatSatUI.hpp"
+#include "FatSatEngine.hpp"
 #include "DistrhoPluginInfo.h"
 #include "../shared/frame_bridge.hpp"
-#include "../bridge/fatsat_bridge.hpp"
-#include "../bridge/frame_bridge_gd.hpp"
+#include "../shared/session_log.hpp"
+#include "../shared/trace.hpp"
 
-#include <dlfcn.h>
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
-#include <cstdlib>
 
 // OpenGL headers
 #if defined(__APPLE__)
@@ -32,345 +32,203 @@
 
 START_NAMESPACE_DISTRHO
 
-// GDExtension initialization callbacks (using godot-cpp pattern)
-extern "C" {
-
-static void fatsat_initialize_module(godot::ModuleInitializationLevel p_level) {
-    if (p_level != godot::MODULE_INITIALIZATION_LEVEL_SCENE) {
-        return;
-    }
-
-    // Register GDExtension classes so GDScript can use them
-    godot::ClassDB::register_class<godot::FatSatBridge>();
-    godot::ClassDB::register_class<godot::FrameBridgeGD>();
-
-    fprintf(stdout, "[FatSat] GDExtension module initialized - registered FatSatBridge and FrameBridgeGD\n");
-}
-
-static void fatsat_uninitialize_module(godot::ModuleInitializationLevel p_level) {
-    if (p_level != godot::MODULE_INITIALIZATION_LEVEL_SCENE) {
-        return;
-    }
-    fprintf(stdout, "[FatSat] GDExtension module uninitialized\n");
-}
-
-GDExtensionBool GDE_EXPORT fatsat_gdextension_init(
-    GDExtensionInterfaceGetProcAddress p_get_proc_address,
-    GDExtensionClassLibraryPtr p_library,
-    GDExtensionInitialization* r_initialization)
-{
-    fprintf(stdout, "[FatSat] GDExtension init called\n");
-
-    godot::GDExtensionBinding::InitObject init_object(p_get_proc_address, p_library, r_initialization);
-
-    init_object.register_initializer(fatsat_initialize_module);
-    init_object.register_terminator(fatsat_uninitialize_module);
-    init_object.set_minimum_library_initialization_level(godot::MODULE_INITIALIZATION_LEVEL_SCENE);
-
-    return init_object.init();
-}
-
-} // extern "C"
-
 FatSatUI::FatSatUI()
     : UI(DISTRHO_UI_DEFAULT_WIDTH, DISTRHO_UI_DEFAULT_HEIGHT),
-      fLibGodotHandle(nullptr),
-      fCreateInstance(nullptr),
-      fDestroyInstance(nullptr),
-      fGodotInstance(nullptr),
-      fGodotStarted(false),
+      fEditorId(0),
+      fBridge(nullptr),
       fParentWindowId(0),
-      fFrameTexture(0),
-      fOpenGLInitialized(false),
-      fTextureWidth(0),
-      fTextureHeight(0),
       fCurrentFatness(0.0f),
       fCurrentOutput(1.0f),
+      fDspLoad(0.0f),
+      fDspLoadPeak(0.0f),
+      fDspOverruns(0),
+      fScheduler(GodotEngineHost::kDefaultMinIterationIntervalNs),
+      fLastIterationCount(0),
       fLastMouseX(0.0f),
       fLastMouseY(0.0f),
-      fFrameSkipCount(0)
-#if !defined(__APPLE__)
-      , fGodotDisplay(nullptr)
-      , fGodotDrawable(0)
-      , fGodotContext(nullptr)
-#endif
+      fFrameSkipCount(0),
+      fRecordSession(false),
+      fStartTimeNs(0),
+      fFirstFrameReported(false),
+      fOpenedWarm(false),
+      fLastFrameNs(0),
+      fStartupFrameCount(0),
+      fStartupHistogram(),
+      fStartupMaxFrameNs(0)
 {
     fParentWindowId = getWindow().getNativeWindowHandle();
 
+    // Don't block the host: the window opens with a placeholder while the
+    // engine boots in the background, or reuses the warm engine right away
+    fStartTimeNs = enlil::hostTimeNs();
+    GodotEngineHost& engine = GodotEngineHost::instance();
+    fOpenedWarm = engine.isRunning();
+
+    // The shared engine renders this window through its own bridge
+    fEditorId = engine.acquire();
+    fBridge = enlil::FrameBridge::forEditor(fEditorId);
+
     // Initialize the frame bridge with our window size
-    enlil::FrameBridge::instance().setRequestedSize(
+    fBridge->setRequestedSize(
         DISTRHO_UI_DEFAULT_WIDTH,
         DISTRHO_UI_DEFAULT_HEIGHT
     );
 
-    if (loadLibGodot()) {
-        initGodot();
+    // Record this editor's input stream and resizes if a session log is open
+    enlil::SessionRecorder& recorder = enlil::SessionRecorder::instance();
+    fRecordSession = recorder.claim(enlil::SESSION_SOURCE_EDITOR, this);
+    if (fRecordSession) {
+        fBridge->setInputObserver(&enlil::SessionRecorder::inputObserver, &recorder);
+        recorder.recordResize(DISTRHO_UI_DEFAULT_WIDTH, DISTRHO_UI_DEFAULT_HEIGHT);
     }
 }
 
 FatSatUI::~FatSatUI()
 {
-    shutdownGodot();
-    unloadLibGodot();
-    cleanupOpenGL();
-}
-
-bool FatSatUI::loadLibGodot()
-{
-    // Try to find libgodot.so in various locations
-    const char* paths[] = {
-        // Relative to plugin location
-        "./libgodot.linuxbsd.template_release.x86_64.so",
-        "../lib/libgodot.linuxbsd.template_release.x86_64.so",
-        // From build output
-        "godot/bin/libgodot.linuxbsd.template_release.x86_64.so",
-        // Symlink name
-        "./libgodot.so",
-        nullptr
-    };
-
-    for (int i = 0; paths[i] != nullptr; ++i) {
-        fLibGodotHandle = dlopen(paths[i], RTLD_NOW | RTLD_LOCAL);
-        if (fLibGodotHandle) {
-            fprintf(stdout, "[FatSat] Loaded LibGodot from: %s\n", paths[i]);
-            break;
-        }
-    }
-
-    if (!fLibGodotHandle) {
-        // Try with just the library name (system search)
-        fLibGodotHandle = dlopen("libgodot.linuxbsd.template_release.x86_64.so", RTLD_NOW | RTLD_LOCAL);
-    }
+    fBlitter.cleanup();
 
-    if (!fLibGodotHandle) {
-        fprintf(stderr, "[FatSat] Failed to load LibGodot: %s\n", dlerror());
-        return false;
+    if (fRecordSession) {
+        fBridge->setInputObserver(nullptr, nullptr);
+        enlil::SessionRecorder::instance().unclaim(enlil::SESSION_SOURCE_EDITOR, this);
     }
 
-    // Get function pointers
-    *(void**)(&fCreateInstance) = dlsym(fLibGodotHandle, "libgodot_create_godot_instance");
-    *(void**)(&fDestroyInstance) = dlsym(fLibGodotHandle, "libgodot_destroy_godot_instance");
-
-    if (!fCreateInstance || !fDestroyInstance) {
-        fprintf(stderr, "[FatSat] Failed to get LibGodot symbols: create=%p destroy=%p\n",
-                (void*)fCreateInstance, (void*)fDestroyInstance);
-        dlclose(fLibGodotHandle);
-        fLibGodotHandle = nullptr;
-        return false;
-    }
-
-    fprintf(stdout, "[FatSat] LibGodot symbols loaded successfully\n");
-    return true;
-}
-
-void FatSatUI::unloadLibGodot()
-{
-    if (fLibGodotHandle) {
-        dlclose(fLibGodotHandle);
-        fLibGodotHandle = nullptr;
-    }
-    fCreateInstance = nullptr;
-    fDestroyInstance = nullptr;
+    // Closes our bridge; the engine stays warm for the next editor
+    GodotEngineHost::instance().release(fEditorId);
+    fBridge = nullptr;
 }
 
-bool FatSatUI::initGodot()
+void FatSatUI::recordStartupFrame(uint64_t nowNs)
 {
-    if (!fCreateInstance) {
-        return false;
-    }
+    static const uint64_t kBucketLimitsMs[kStartupBuckets - 1] = { 8, 16, 33, 50, 100 };
 
-    // Build command line arguments for Godot
-    // Godot creates its own window for rendering. We extract frames via FrameBridge.
-    const char* args[] = {
-        "fatsat",
-        "--path", "src/godot",
-        "--rendering-method", "gl_compatibility",
-        "--rendering-driver", "opengl3",
-        nullptr
-    };
-
-    int argc = 0;
-    while (args[argc] != nullptr) {
-        ++argc;
-    }
-
-    fprintf(stdout, "[FatSat] Creating Godot instance with offscreen window, %d args\n", argc);
-
-    // Create the Godot instance using 3-arg signature
-    GDExtensionObjectPtr instancePtr = fCreateInstance(argc, (char**)args, fatsat_gdextension_init);
-
-    if (!instancePtr) {
-        fprintf(stderr, "[FatSat] Failed to create Godot instance\n");
-        return false;
+    if (fStartupFrameCount >= kStartupFrames) {
+        return;
     }
 
-    // Get the godot-cpp wrapper for the instance
-    fGodotInstance = reinterpret_cast<godot::GodotInstance*>(
-        godot::internal::get_object_instance_binding(instancePtr)
-    );
-
-    if (!fGodotInstance) {
-        fprintf(stderr, "[FatSat] Failed to get GodotInstance binding\n");
-        return false;
+    const uint64_t lastNs = fLastFrameNs;
+    fLastFrameNs = nowNs;
+    if (lastNs == 0) {
+        return;
     }
 
-    fprintf(stdout, "[FatSat] Godot instance created, starting engine...\n");
-
-    // Start the engine using godot-cpp method
-    fGodotInstance->start();
-    fGodotStarted = true;
-
-#if !defined(__APPLE__)
-    // Capture Godot's GLX context info right after start() while it's still current.
-    // We'll need this to restore the context before each iteration().
-    fGodotDisplay = glXGetCurrentDisplay();
-    fGodotDrawable = glXGetCurrentDrawable();
-    fGodotContext = glXGetCurrentContext();
-#endif
-
-    return true;
-}
-
-void FatSatUI::shutdownGodot()
-{
-    if (fGodotInstance && fDestroyInstance) {
-        // Get the raw object pointer for destruction
-        GDExtensionObjectPtr obj = godot::internal::gdextension_interface_object_get_instance_from_id(
-            fGodotInstance->get_instance_id()
-        );
-        fDestroyInstance(obj);
-        fGodotInstance = nullptr;
-        fGodotStarted = false;
-        fprintf(stdout, "[FatSat] Godot instance destroyed\n");
+    const uint64_t frameNs = nowNs - lastNs;
+    uint32_t bucket = 0;
+    while (bucket < kStartupBuckets - 1 && frameNs >= kBucketLimitsMs[bucket] * 1000000) {
+        bucket++;
     }
-}
+    fStartupHistogram[bucket]++;
+    fStartupMaxFrameNs = std::max(fStartupMaxFrameNs, frameNs);
 
-void FatSatUI::initOpenGL()
-{
-    if (fOpenGLInitialized) {
+    if (++fStartupFrameCount < kStartupFrames) {
         return;
     }
 
-    // Generate texture for frame display
-    glGenTextures(1, &fFrameTexture);
-    glBindTexture(GL_TEXTURE_2D, fFrameTexture);
-
-    // Set texture parameters
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-    glBindTexture(GL_TEXTURE_2D, 0);
-
-    fOpenGLInitialized = true;
-}
-
-void FatSatUI::cleanupOpenGL()
-{
-    if (fFrameTexture != 0) {
-        glDeleteTextures(1, &fFrameTexture);
-        fFrameTexture = 0;
-    }
-    fOpenGLInitialized = false;
+    fprintf(stdout, "[FatSat] First %u frames (%s): <8ms %u, <16ms %u, <33ms %u, <50ms %u, "
+                    "<100ms %u, >=100ms %u, max %.1f ms\n",
+            kStartupFrames, fOpenedWarm ? "warm engine" : "cold start",
+            fStartupHistogram[0], fStartupHistogram[1], fStartupHistogram[2],
+            fStartupHistogram[3], fStartupHistogram[4], fStartupHistogram[5],
+            fStartupMaxFrameNs / 1.0e6);
 }
 
 void FatSatUI::uploadFrameTexture()
 {
-    auto& bridge = enlil::FrameBridge::instance();
+    ENLIL_TRACE_SCOPE("FatSatUI::uploadFrameTexture");
 
-    // Check if we have a new frame
-    if (!bridge.hasNewFrame()) {
+    if (!fBlitter.upload(*fBridge)) {
         return;
     }
 
-    const uint8_t* data = bridge.getFrameData();
-    int width = bridge.getFrameWidth();
-    int height = bridge.getFrameHeight();
-
-    if (!data || width <= 0 || height <= 0) {
-        return;
+    if (!fFirstFrameReported) {
+        fFirstFrameReported = true;
+        fprintf(stdout, "[FatSat] Editor open to first frame: %.1f ms (%s, %s LibGodot, %s)\n",
+                (enlil::hostTimeNs() - fStartTimeNs) / 1.0e6,
+                fOpenedWarm ? "warm engine" : "cold start",
+                LibGodotLoader::isStaticallyLinked() ? "static" : "dlopen",
+                GodotEngineHost::instance().isUsingEmbeddedPck() ? "embedded PCK" : "project directory");
+
+        const GodotEngineHost& engine = GodotEngineHost::instance();
+        const size_t editors = engine.getEditorCount();
+        const double engineMiB = engine.getMemoryUsage() / 1048576.0;
+        fprintf(stdout, "[FatSat] Engine memory: %.1f MiB for %zu editor(s), %.1f MiB per editor\n",
+                engineMiB, editors, editors > 0 ? engineMiB / editors : engineMiB);
     }
 
-    glBindTexture(GL_TEXTURE_2D, fFrameTexture);
-
-    // Upload texture data
-    if (width != fTextureWidth || height != fTextureHeight) {
-        // Texture size changed, reallocate
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0,
-                     GL_RGBA, GL_UNSIGNED_BYTE, data);
-        fTextureWidth = width;
-        fTextureHeight = height;
-    } else {
-        // Same size, just update
-        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height,
-                        GL_RGBA, GL_UNSIGNED_BYTE, data);
-    }
-
-    glBindTexture(GL_TEXTURE_2D, 0);
+#ifdef ENLIL_TRACE
+    recordStartupFrame(enlil::hostTimeNs());
+#endif
 }
 
-void FatSatUI::drawFullscreenQuad()
+void FatSatUI::applyFrameSchedule()
 {
-    if (fTextureWidth <= 0 || fTextureHeight <= 0) {
-        return;
-    }
-
-    // Save OpenGL state
-    glPushAttrib(GL_ENABLE_BIT | GL_TEXTURE_BIT);
+    fBridge->setFrameInterval(fScheduler.getFrameIntervalNs());
+    fBridge->setReadbackInterval(fScheduler.getReadbackInterval());
+    fBridge->setUIQuality(fScheduler.getQuality());
+
+#ifdef ENLIL_TRACE
+    fprintf(stdout, "[FatSat] UI quality %s, %.0f fps (DSP load %.1f%%, peak %.1f%%, "
+                    "UI %.1f%% of a core, budget %.0f%%)\n",
+            enlil::UIFrameScheduler::getQualityName(fScheduler.getQuality()),
+            1.0e9 / fScheduler.getFrameIntervalNs(), fDspLoad, fDspLoadPeak,
+            fScheduler.getUiLoad(), fScheduler.getBudget());
+#endif
+}
 
-    // Setup for 2D rendering
+void FatSatUI::drawPlaceholder()
+{
+    // Shown until Godot delivers its first frame: a thin indeterminate
+    // progress bar, drawn with plain GL so it costs nothing to set up
+    const float width = (float)getWidth();
+    const float height = (float)getHeight();
+    const float barWidth = width * 0.4f;
+    const float barHeight = 4.0f;
+    const float x0 = (width - barWidth) * 0.5f;
+    const float y0 = (height - barHeight) * 0.5f;
+
+    glPushAttrib(GL_ENABLE_BIT | GL_CURRENT_BIT);
     glDisable(GL_DEPTH_TEST);
-    glDisable(GL_LIGHTING);
-    glEnable(GL_TEXTURE_2D);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glDisable(GL_TEXTURE_2D);
+    glDisable(GL_BLEND);
 
-    // Setup orthographic projection
     glMatrixMode(GL_PROJECTION);
     glPushMatrix();
     glLoadIdentity();
-    glOrtho(0, getWidth(), getHeight(), 0, -1, 1);
+    glOrtho(0, width, height, 0, -1, 1);
 
     glMatrixMode(GL_MODELVIEW);
     glPushMatrix();
     glLoadIdentity();
 
-    // Bind texture and draw quad
-    glBindTexture(GL_TEXTURE_2D, fFrameTexture);
-    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-
-    glBegin(GL_QUADS);
-    // Top-left
-    glTexCoord2f(0.0f, 0.0f);
-    glVertex2f(0.0f, 0.0f);
-    // Top-right
-    glTexCoord2f(1.0f, 0.0f);
-    glVertex2f((float)getWidth(), 0.0f);
-    // Bottom-right
-    glTexCoord2f(1.0f, 1.0f);
-    glVertex2f((float)getWidth(), (float)getHeight());
-    // Bottom-left
-    glTexCoord2f(0.0f, 1.0f);
-    glVertex2f(0.0f, (float)getHeight());
-    glEnd();
-
-    glBindTexture(GL_TEXTURE_2D, 0);
-
-    // Restore matrices
+    // Track
+    const bool failed = GodotEngineHost::instance().hasFailed();
+
+    if (failed) {
+        glColor4f(0.45f, 0.16f, 0.16f, 1.0f);
+    } else {
+        glColor4f(0.20f, 0.20f, 0.24f, 1.0f);
+    }
+    glRectf(x0, y0, x0 + barWidth, y0 + barHeight);
+
+    // Sliding segment, one sweep per second
+    if (!failed) {
+        const float phase = (float)((enlil::hostTimeNs() / 1000000ULL) % 1000ULL) / 1000.0f;
+        const float segment = barWidth * 0.25f;
+        const float start = x0 + phase * (barWidth + segment) - segment;
+        const float left = start < x0 ? x0 : start;
+        const float right = (start + segment) > (x0 + barWidth) ? (x0 + barWidth) : (start + segment);
+
+        if (right > left) {
+            glColor4f(0.85f, 0.55f, 0.20f, 1.0f);
+            glRectf(left, y0, right, y0 + barHeight);
+        }
+    }
+
     glMatrixMode(GL_MODELVIEW);
     glPopMatrix();
     glMatrixMode(GL_PROJECTION);
     glPopMatrix();
 
-    // Restore OpenGL state
     glPopAttrib();
-
-    // Check for GL errors
-    GLenum err = glGetError();
-    if (err != GL_NO_ERROR) {
-        fprintf(stderr, "[FatSat] GL error in drawFullscreenQuad: 0x%x\n", err);
-    }
 }
 
 void FatSatUI::parameterChanged(uint32_t index, float value)
@@ -384,9 +242,25 @@ void FatSatUI::parameterChanged(uint32_t index, float value)
         fCurrentOutput = value;
         // TODO: Send to Godot UI via DSP bridge
         break;
+    case 2: // kParamDspLoad
+        fDspLoad = value;
+        fScheduler.setDspLoad(fDspLoad, fDspLoadPeak);
+        break;
+    case 3: // kParamDspLoadPeak
+        fDspLoadPeak = value;
+        fScheduler.setDspLoad(fDspLoad, fDspLoadPeak);
+        break;
+    case 4: // kParamDspOverruns
+        fDspOverruns = static_cast<uint32_t>(value);
+        fScheduler.setDspOverruns(fDspOverruns);
+        break;
     }
 
-    repaint();
+    // Meter updates arrive many times a second; only the knobs need an
+    // immediate repaint while the UI is throttled
+    if (index < 2 || fScheduler.getQuality() == enlil::UI_QUALITY_FULL) {
+        repaint();
+    }
 }
 
 void FatSatUI::stateChanged(const char* key, const char* value)
@@ -397,28 +271,32 @@ void FatSatUI::stateChanged(const char* key, const char* value)
 
 void FatSatUI::uiIdle()
 {
+    ENLIL_TRACE_THREAD("ui");
+    ENLIL_TRACE_SCOPE("FatSatUI::uiIdle");
+
+    GodotEngineHost& engine = GodotEngineHost::instance();
+
+    // Bring the engine up one stage per idle tick, repainting in between
+    if (!engine.isRunning()) {
+        engine.advanceStartup();
+    }
+
     // Run Godot frame iteration here (NOT in onDisplay)
     // This separates Godot's context management from DPF's OpenGL context
-    if (fGodotStarted && fGodotInstance) {
-#if !defined(__APPLE__)
-        // Switch to Godot's OpenGL context before iteration
-        if (fGodotDisplay && fGodotContext) {
-            glXMakeCurrent(fGodotDisplay, fGodotDrawable, fGodotContext);
-        }
-#endif
-
-        // Run Godot's frame with its context now active
-        fGodotInstance->iteration();
+    if (engine.isRunning()) {
+        // Publish coalesced input so Godot sees it this frame
+        fBridge->flushInputEvents();
 
-#if !defined(__APPLE__)
-        // Ensure Godot's rendering is complete
-        glFinish();
+        const uint64_t iterateStart = enlil::hostTimeNs();
+        if (engine.iterate()) {
+            fScheduler.addBusyTime(enlil::hostTimeNs() - iterateStart);
+        }
 
-        // Unbind context - DPF will bind its own in onDisplay()
-        if (fGodotDisplay) {
-            glXMakeCurrent(fGodotDisplay, None, nullptr);
+        // Hand state changes from the Godot UI (drawn curves) to the plugin
+        std::string stateKey, stateValue;
+        while (fBridge->takeStateValue(stateKey, stateValue)) {
+            setState(stateKey.c_str(), stateValue.c_str());
         }
-#endif
 
         // Skip first few frames to let Godot fully initialize
         if (fFrameSkipCount < 5) {
@@ -428,35 +306,63 @@ void FatSatUI::uiIdle()
         // Note: DPF will re-bind its context when onDisplay() is called
     }
 
-    // Request repaint to display captured frame
-    repaint();
+    if (fScheduler.update(enlil::hostTimeNs())) {
+        applyFrameSchedule();
+    }
+
+    // Request repaint to display captured frame. While throttled, only when
+    // the engine has run since (possibly from another editor's uiIdle)
+    const uint64_t iterationCount = engine.getIterationCount();
+    if (fScheduler.getQuality() == enlil::UI_QUALITY_FULL || !fBlitter.hasFrame() ||
+        iterationCount != fLastIterationCount) {
+        fLastIterationCount = iterationCount;
+        repaint();
+    }
 }
 
 void FatSatUI::onDisplay()
 {
+    ENLIL_TRACE_SCOPE("FatSatUI::onDisplay");
+
+    const uint64_t displayStart = enlil::hostTimeNs();
+
     // DPF's OpenGL context is active here - only do DPF OpenGL operations
     // Godot iteration happens in uiIdle() to avoid context conflicts
 
     // Initialize our OpenGL resources (in DPF's context)
-    if (!fOpenGLInitialized) {
-        initOpenGL();
+    if (!fBlitter.isInitialized()) {
+        fBlitter.init();
     }
 
-    // Clear to dark gray background
-    glClearColor(0.12f, 0.12f, 0.15f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT);
-
     // Upload frame from Godot if available (CPU data, no context conflict)
     uploadFrameTexture();
 
-    // Draw the frame
-    drawFullscreenQuad();
+    // Clear to dark gray background, unless an opaque frame covers it
+    if (!fBlitter.hasFrame() || !fBlitter.isOpaque()) {
+        glClearColor(0.12f, 0.12f, 0.15f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+    }
+
+    // Draw the frame, or the placeholder until Godot has produced one
+    if (fBlitter.hasFrame()) {
+        fBlitter.draw(getWidth(), getHeight());
+        // DPF swaps right after onDisplay(), count the frame as presented
+        fBridge->markFramePresented();
+    } else {
+        drawPlaceholder();
+    }
+
+    fScheduler.addBusyTime(enlil::hostTimeNs() - displayStart);
 }
 
 void FatSatUI::uiReshape(uint width, uint height)
 {
     // Notify Godot of resize via FrameBridge
-    enlil::FrameBridge::instance().setRequestedSize(width, height);
+    fBridge->setRequestedSize(width, height);
+
+    if (fRecordSession) {
+        enlil::SessionRecorder::instance().recordResize(width, height);
+    }
 
     // Setup viewport
     glViewport(0, 0, width, height);
@@ -464,8 +370,13 @@ void FatSatUI::uiReshape(uint width, uint height)
 
 bool FatSatUI::onMouse(const MouseEvent& ev)
 {
+    // Nothing to receive input yet; don't queue stale clicks for startup
+    if (!GodotEngineHost::instance().isRunning()) {
+        return false;
+    }
+
     // Forward mouse button events to Godot
-    enlil::FrameBridge::instance().pushMouseButton(
+    fBridge->pushMouseButton(
         ev.pos.getX(),
         ev.pos.getY(),
         ev.button,
@@ -480,8 +391,12 @@ bool FatSatUI::onMouse(const MouseEvent& ev)
 
 bool FatSatUI::onMotion(const MotionEvent& ev)
 {
+    if (!GodotEngineHost::instance().isRunning()) {
+        return false;
+    }
+
     // Forward mouse motion events to Godot
-    enlil::FrameBridge::instance().pushMouseMotion(
+    fBridge->pushMouseMotion(
         ev.pos.getX(),
         ev.pos.getY()
     );
@@ -494,8 +409,12 @@ bool FatSatUI::onMotion(const MotionEvent& ev)
 
 bool FatSatUI::onScroll(const ScrollEvent& ev)
 {
+    if (!GodotEngineHost::instance().isRunning()) {
+        return false;
+    }
+
     // Forward scroll events to Godot
-    enlil::FrameBridge::instance().pushScroll(
+    fBridge->pushScroll(
         ev.pos.getX(),
         ev.pos.getY(),
         ev.delta.getX(),
@@ -507,8 +426,12 @@ bool FatSatUI::onScroll(const ScrollEvent& ev)
 
 bool FatSatUI::onKeyboard(const KeyboardEvent& ev)
 {
+    if (!GodotEngineHost::instance().isRunning()) {
+        return false;
+    }
+
     // Forward keyboard events to Godot
-    enlil::FrameBridge::instance().pushKey(
+    fBridge->pushKey(
         ev.key,
         ev.press
     );
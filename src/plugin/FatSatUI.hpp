@@ -13,20 +13,12 @@
 #endif
 
 #include "DistrhoUI.hpp"
-
-#include <godot_cpp/core/defs.hpp>
-#include <godot_cpp/godot.hpp>
-#include <godot_cpp/classes/godot_instance.hpp>
+#include "FatSatBlitter.hpp"
+#include "../shared/frame_bridge.hpp"
+#include "../shared/ui_scheduler.hpp"
 
 START_NAMESPACE_DISTRHO
 
-// LibGodot API function pointer types (simplified 3-arg signature)
-typedef GDExtensionObjectPtr (*LibGodotCreateInstanceFunc)(
-    int p_argc, char* p_argv[],
-    GDExtensionInitializationFunction p_init_func
-);
-typedef void (*LibGodotDestroyInstanceFunc)(GDExtensionObjectPtr p_godot_instance);
-
 class FatSatUI : public UI {
 public:
     FatSatUI();
@@ -47,40 +39,36 @@ protected:
     bool onKeyboard(const KeyboardEvent& ev) override;
 
 private:
-    // LibGodot management
-    bool loadLibGodot();
-    void unloadLibGodot();
-    bool initGodot();
-    void shutdownGodot();
-
     // OpenGL helpers
-    void initOpenGL();
-    void cleanupOpenGL();
     void uploadFrameTexture();
-    void drawFullscreenQuad();
+    void drawPlaceholder();
 
-    // LibGodot library handle and function pointers
-    void* fLibGodotHandle;
-    LibGodotCreateInstanceFunc fCreateInstance;
-    LibGodotDestroyInstanceFunc fDestroyInstance;
+    // Hand the scheduler's decisions to the engine and Godot
+    void applyFrameSchedule();
 
-    // Godot instance (using godot-cpp wrapper)
-    godot::GodotInstance* fGodotInstance;
-    bool fGodotStarted;
+    // Editor ID in the shared engine and the bridge it renders through
+    uint32_t fEditorId;
+    enlil::FrameBridge* fBridge;
 
     // DPF window info (no longer used for embedding, kept for reference)
     uintptr_t fParentWindowId;
 
-    // OpenGL texture for frame display
-    unsigned int fFrameTexture;
-    bool fOpenGLInitialized;
-    int fTextureWidth;
-    int fTextureHeight;
+    // Frame texture upload and drawing
+    FrameBlitter fBlitter;
 
     // Cached parameter values
     float fCurrentFatness;
     float fCurrentOutput;
 
+    // DSP load output parameters of this instance
+    float fDspLoad;
+    float fDspLoadPeak;
+    uint32_t fDspOverruns;
+
+    // Trades UI fidelity for CPU while audio is under pressure
+    enlil::UIFrameScheduler fScheduler;
+    uint64_t fLastIterationCount;
+
     // Mouse state tracking
     float fLastMouseX;
     float fLastMouseY;
@@ -88,12 +76,24 @@ private:
     // Frame skip counter for Godot initialization
     int fFrameSkipCount;
 
-#if !defined(__APPLE__)
-    // Godot's GLX context info - captured after start() so we can restore it
-    Display* fGodotDisplay;
-    GLXDrawable fGodotDrawable;
-    GLXContext fGodotContext;
-#endif
+    // This editor feeds the session log (FATSAT_RECORD_SESSION)
+    bool fRecordSession;
+
+    // Open timing (window open → first frame uploaded)
+    uint64_t fStartTimeNs;
+    bool fFirstFrameReported;
+    bool fOpenedWarm;
+
+    // Frame-time histogram of the first kStartupFrames frames after open,
+    // where shader compilation hitches show up (printed in trace builds only)
+    static constexpr uint32_t kStartupFrames = 120;
+    static constexpr uint32_t kStartupBuckets = 6;
+    void recordStartupFrame(uint64_t nowNs);
+
+    uint64_t fLastFrameNs;
+    uint32_t fStartupFrameCount;
+    uint32_t fStartupHistogram[kStartupBuckets];
+    uint64_t fStartupMaxFrameNs;
 
     DISTRHO_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FatSatUI)
 };
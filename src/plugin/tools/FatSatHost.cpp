@@ -0,0 +1,524 @@
+/*
+ * FatSat Host - Headless multi-instance host for DSP scaling tests
+ * Part of the Enlil/GodotVST Framework
+ *
+ * Instantiates N FatSat DSP instances through DPF's PluginExporter (the
+ * same entry points the plugin format wrappers use) and processes them
+ * offline, without audio hardware. Every audio cycle, a worker pool runs
+ * all instances in parallel like a DAW's parallel graph and waits at a
+ * barrier; the cycle must finish within its real-time budget
+ * (block size / sample rate) or it would have been an xrun.
+ *
+ * Parameters get randomized automation every block, and blocks are
+ * occasionally split at a random position like hosts do at automation
+ * points. Other blocks get frame-stamped points instead, the way wrappers
+ * with sample-accurate automation hand them to the plugin.
+ *
+ * Reports:
+ * - the largest instance count that still meets the deadline
+ * - scaling efficiency of the worker pool per thread count
+ * - tail latency of single run() calls and whole cycles
+ * - memory of the DSP tables the instances share (DSPTableCache)
+ *
+ * Usage: fatsat_host [--threads T] [--block N] [--rate HZ] [--seconds S]
+ *                    [--max-instances N] [--step N] [--quality Q]
+ *                    [--json results.json]
+ *
+ * --quality sets every instance's Quality parameter (auto, eco, normal, hq;
+ * default auto) to compare how far each DSP tier scales.
+ */
+
+#include "DistrhoPluginInfo.h"
+
+// DPF plugin internals: PluginExporter and the d_next* creation globals
+#include "src/DistrhoPlugin.cpp"
+#if __has_include("src/DistrhoUtils.cpp")
+#include "src/DistrhoUtils.cpp"
+#endif
+
+#include "../FatSatPlugin.hpp"
+#include "table_cache.hpp"
+#include "bench/bench.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+START_NAMESPACE_DISTRHO
+
+using enlil::bench::nowNs;
+using enlil::bench::percentile;
+
+// Callbacks FatSat never uses, but PluginExporter wants
+static bool writeMidiCallback(void*, const MidiEvent&) { return false; }
+static bool requestParameterValueChangeCallback(void*, uint32_t, float) { return false; }
+static bool updateStateValueCallback(void*, const char*, const char*) { return false; }
+
+struct HostConfig {
+    uint32_t threads;
+    uint32_t blockSize;
+    double sampleRate;
+    double seconds;
+    uint32_t maxInstances;
+    uint32_t step;
+    uint32_t quality;
+    const char* jsonPath;
+};
+
+static const char* const kQualityNames[] = { "auto", "eco", "normal", "hq" };
+
+// One plugin instance with its own buffers and automation state
+struct Instance {
+    std::unique_ptr<PluginExporter> plugin;
+    FatSatPlugin* dsp;
+    std::vector<float> input[2];
+    std::vector<float> output[2];
+    std::mt19937 random;
+    float fatness;
+
+    // run() durations of the current measurement (owned by one worker at a time)
+    std::vector<double> runNs;
+};
+
+// === Instances ===
+
+static std::unique_ptr<Instance> createInstance(const HostConfig& config, uint32_t seed)
+{
+    d_nextBufferSize = config.blockSize;
+    d_nextSampleRate = config.sampleRate;
+
+    std::unique_ptr<Instance> instance(new Instance());
+    instance->plugin.reset(new PluginExporter(instance.get(),
+                                              writeMidiCallback,
+                                              requestParameterValueChangeCallback,
+                                              updateStateValueCallback));
+    instance->dsp = static_cast<FatSatPlugin*>(instance->plugin->getInstancePointer());
+    instance->random.seed(seed);
+    instance->fatness = 0.5f;
+    instance->plugin->setParameterValue(kParamQuality, static_cast<float>(config.quality));
+
+    // Decorrelated noise per instance, generated once
+    std::uniform_real_distribution<float> noise(-0.5f, 0.5f);
+    for (int channel = 0; channel < 2; ++channel) {
+        instance->input[channel].resize(config.blockSize);
+        instance->output[channel].resize(config.blockSize);
+        for (float& sample : instance->input[channel]) {
+            sample = noise(instance->random);
+        }
+    }
+
+    instance->plugin->activate();
+    return instance;
+}
+
+// Randomized automation, then the block, possibly split like a host does
+// at an automation point or with frame-stamped points inside it
+static void processInstance(Instance& instance, uint32_t frames)
+{
+    std::uniform_real_distribution<float> step(-0.02f, 0.02f);
+    instance.fatness = std::min(1.0f, std::max(0.0f, instance.fatness + step(instance.random)));
+    instance.plugin->setParameterValue(kParamFatness, instance.fatness);
+
+    uint32_t split = frames;
+    if (frames >= 32 && (instance.random() % 5) == 0) {
+        split = 16 + instance.random() % (frames - 16);
+    }
+
+    uint32_t offset = 0;
+    while (offset < frames) {
+        const uint32_t count = (offset == 0) ? split : frames - offset;
+        const float* inputs[2] = { instance.input[0].data() + offset, instance.input[1].data() + offset };
+        float* outputs[2] = { instance.output[0].data() + offset, instance.output[1].data() + offset };
+
+        if ((instance.random() % 4) == 0) {
+            const uint32_t points = 1 + instance.random() % 3;
+            for (uint32_t i = 0; i < points; ++i) {
+                std::uniform_real_distribution<float> output(0.5f, 1.0f);
+                instance.dsp->setParameterValueAtFrame(kParamOutput, output(instance.random),
+                                                       instance.random() % count);
+            }
+        }
+
+        const uint64_t start = nowNs();
+        instance.plugin->run(inputs, outputs, count);
+        instance.runNs.push_back(static_cast<double>(nowNs() - start));
+
+        offset += count;
+        if (offset < frames) {
+            instance.plugin->setParameterValue(kParamOutput, 0.5f + 0.5f * instance.fatness);
+        }
+    }
+}
+
+// === Worker pool ===
+
+// Runs every instance once per cycle across the workers plus the calling
+// (host audio) thread, which waits at the end like a graph's sink node
+class WorkerPool {
+public:
+    WorkerPool(uint32_t threads)
+        : fInstances(nullptr),
+          fFrames(0),
+          fCycle(0),
+          fClaim(0),
+          fPending(0),
+          fQuit(false)
+    {
+        for (uint32_t i = 1; i < threads; ++i) {
+            fWorkers.emplace_back([this] { workerLoop(); });
+        }
+    }
+
+    ~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(fMutex);
+            fQuit = true;
+            fCycle++;
+        }
+        fWake.notify_all();
+        for (std::thread& worker : fWorkers) {
+            worker.join();
+        }
+    }
+
+    void runCycle(std::vector<std::unique_ptr<Instance>>& instances, uint32_t frames)
+    {
+        // Pending is set before the claims open: a worker still in the last
+        // cycle's processShare() cannot claim (and count down) this one
+        uint64_t cycle;
+        fPending.store(static_cast<uint32_t>(instances.size()), std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(fMutex);
+            fInstances = &instances;
+            fFrames = frames;
+            cycle = ++fCycle;
+            fClaim.store(claimFor(cycle, 0), std::memory_order_release);
+        }
+        fWake.notify_all();
+
+        processShare(instances, frames, cycle);
+
+        // Spin at the barrier: the audio thread does not sleep mid-cycle
+        while (fPending.load(std::memory_order_acquire) != 0) {
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    void workerLoop()
+    {
+        uint64_t seenCycle = 0;
+        for (;;) {
+            std::vector<std::unique_ptr<Instance>>* instances;
+            uint32_t frames;
+            {
+                std::unique_lock<std::mutex> lock(fMutex);
+                fWake.wait(lock, [&] { return fCycle != seenCycle; });
+                seenCycle = fCycle;
+                if (fQuit) {
+                    return;
+                }
+                instances = fInstances;
+                frames = fFrames;
+            }
+            processShare(*instances, frames, seenCycle);
+        }
+    }
+
+    // Claims carry the cycle in the upper half and the next instance index
+    // in the lower half
+    static uint64_t claimFor(uint64_t cycle, uint32_t index)
+    {
+        return (cycle << 32) | index;
+    }
+
+    // Claim instances of the given cycle until none are left
+    void processShare(std::vector<std::unique_ptr<Instance>>& instances, uint32_t frames,
+                      uint64_t cycle)
+    {
+        uint64_t claim = fClaim.load(std::memory_order_acquire);
+        for (;;) {
+            const uint32_t index = static_cast<uint32_t>(claim);
+            if (claim >> 32 != (cycle & 0xFFFFFFFFu) || index >= instances.size()) {
+                return;
+            }
+            if (!fClaim.compare_exchange_weak(claim, claim + 1, std::memory_order_acq_rel,
+                                              std::memory_order_acquire)) {
+                continue;
+            }
+            processInstance(*instances[index], frames);
+            fPending.fetch_sub(1, std::memory_order_release);
+            claim = fClaim.load(std::memory_order_acquire);
+        }
+    }
+
+    std::vector<std::thread> fWorkers;
+    std::mutex fMutex;
+    std::condition_variable fWake;
+
+    std::vector<std::unique_ptr<Instance>>* fInstances;
+    uint32_t fFrames;
+    uint64_t fCycle;
+    std::atomic<uint64_t> fClaim;
+    std::atomic<uint32_t> fPending;
+    bool fQuit;
+};
+
+// === Measurement ===
+
+struct RunResult {
+    uint32_t instances;
+    uint32_t threads;
+    uint64_t cycles;
+    uint64_t xruns;
+    double totalSeconds;
+    double cycleP50Us;
+    double cycleP99Us;
+    double cycleMaxUs;
+    double runP50Us;
+    double runP99Us;
+    double runP999Us;
+
+    // Shared tables while the instances were alive
+    enlil::DSPTableCache::Stats tables;
+};
+
+// A run meets the deadline if at most this fraction of cycles overran
+static constexpr double kMaxXrunRatio = 0.001;
+
+static RunResult measure(const HostConfig& config, uint32_t instanceCount, uint32_t threads)
+{
+    std::vector<std::unique_ptr<Instance>> instances;
+    for (uint32_t i = 0; i < instanceCount; ++i) {
+        instances.push_back(createInstance(config, 1234 + i));
+    }
+
+    WorkerPool pool(threads);
+    const double budgetNs = config.blockSize / config.sampleRate * 1.0e9;
+    const uint64_t cycles = static_cast<uint64_t>(config.seconds * config.sampleRate / config.blockSize);
+
+    // Warm caches and the branch predictor before measuring
+    for (int i = 0; i < 16; ++i) {
+        pool.runCycle(instances, config.blockSize);
+    }
+    for (std::unique_ptr<Instance>& instance : instances) {
+        instance->runNs.clear();
+        instance->runNs.reserve(cycles * 2);
+    }
+
+    std::vector<double> cycleNs;
+    cycleNs.reserve(cycles);
+    uint64_t xruns = 0;
+
+    const uint64_t start = nowNs();
+    for (uint64_t cycle = 0; cycle < cycles; ++cycle) {
+        const uint64_t cycleStart = nowNs();
+        pool.runCycle(instances, config.blockSize);
+        const double elapsed = static_cast<double>(nowNs() - cycleStart);
+        cycleNs.push_back(elapsed);
+        if (elapsed > budgetNs) {
+            xruns++;
+        }
+    }
+    const uint64_t total = nowNs() - start;
+    const enlil::DSPTableCache::Stats tables = enlil::DSPTableCache::instance().getStats();
+
+    std::vector<double> runNs;
+    for (std::unique_ptr<Instance>& instance : instances) {
+        runNs.insert(runNs.end(), instance->runNs.begin(), instance->runNs.end());
+        instance->plugin->deactivate();
+    }
+
+    RunResult result;
+    result.instances = instanceCount;
+    result.threads = threads;
+    result.cycles = cycles;
+    result.xruns = xruns;
+    result.totalSeconds = total / 1.0e9;
+    result.cycleP50Us = percentile(cycleNs, 50.0) / 1000.0;
+    result.cycleP99Us = percentile(cycleNs, 99.0) / 1000.0;
+    result.cycleMaxUs = cycleNs.empty() ? 0.0 : *std::max_element(cycleNs.begin(), cycleNs.end()) / 1000.0;
+    result.runP50Us = percentile(runNs, 50.0) / 1000.0;
+    result.runP99Us = percentile(runNs, 99.0) / 1000.0;
+    result.runP999Us = percentile(runNs, 99.9) / 1000.0;
+    result.tables = tables;
+    return result;
+}
+
+static bool meetsDeadline(const RunResult& result)
+{
+    return result.xruns <= result.cycles * kMaxXrunRatio;
+}
+
+static void printResult(const RunResult& result, double budgetUs)
+{
+    printf("  %5u inst %2u thr  cycle p50 %8.1f us  p99 %8.1f us  max %8.1f us  (budget %.1f us)"
+           "  run p99 %6.1f us  xruns %llu/%llu\n",
+           result.instances, result.threads, result.cycleP50Us, result.cycleP99Us, result.cycleMaxUs,
+           budgetUs, result.runP99Us,
+           static_cast<unsigned long long>(result.xruns), static_cast<unsigned long long>(result.cycles));
+    fflush(stdout);
+}
+
+static void writeResultJson(FILE* file, const RunResult& result, bool last)
+{
+    fprintf(file, "    {\"instances\": %u, \"threads\": %u, \"cycles\": %llu, \"xruns\": %llu, "
+                  "\"cycle_p50_us\": %.2f, \"cycle_p99_us\": %.2f, \"cycle_max_us\": %.2f, "
+                  "\"run_p50_us\": %.3f, \"run_p99_us\": %.3f, \"run_p999_us\": %.3f}%s\n",
+            result.instances, result.threads,
+            static_cast<unsigned long long>(result.cycles), static_cast<unsigned long long>(result.xruns),
+            result.cycleP50Us, result.cycleP99Us, result.cycleMaxUs,
+            result.runP50Us, result.runP99Us, result.runP999Us, last ? "" : ",");
+}
+
+static int runHost(const HostConfig& config)
+{
+    const double budgetUs = config.blockSize / config.sampleRate * 1.0e6;
+    printf("[FatSatHost] %u threads, block %u @ %.0f Hz (budget %.1f us), %.1f s per step, "
+           "quality %s\n",
+           config.threads, config.blockSize, config.sampleRate, budgetUs, config.seconds,
+           kQualityNames[config.quality]);
+
+    // 1. Ramp the instance count until the deadline is missed
+    printf("[FatSatHost] Instance ramp\n");
+    std::vector<RunResult> ramp;
+    uint32_t maxAtDeadline = 0;
+    for (uint32_t count = config.step; count <= config.maxInstances; count += config.step) {
+        const RunResult result = measure(config, count, config.threads);
+        printResult(result, budgetUs);
+        ramp.push_back(result);
+        if (!meetsDeadline(result)) {
+            break;
+        }
+        maxAtDeadline = count;
+    }
+    printf("[FatSatHost] Instances at deadline: %u\n", maxAtDeadline);
+
+    // Table memory at the largest instance count measured
+    enlil::DSPTableCache::Stats tables = {};
+    if (!ramp.empty()) {
+        tables = ramp.back().tables;
+        printf("[FatSatHost] Shared DSP tables with %u instances: %zu (%.1f KB), %zu references, "
+               "%.1f KB saved\n",
+               ramp.back().instances, tables.tables, tables.bytes / 1024.0, tables.references,
+               tables.bytesSaved / 1024.0);
+    }
+
+    // 2. Scaling efficiency at a fixed load: speedup over one thread / threads
+    const uint32_t scalingInstances = std::max(config.step, maxAtDeadline);
+    printf("[FatSatHost] Thread scaling with %u instances\n", scalingInstances);
+    std::vector<uint32_t> threadCounts;
+    for (uint32_t threads = 1; threads < config.threads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(config.threads);
+
+    std::vector<RunResult> scaling;
+    std::vector<double> efficiency;
+    double singleThreadSeconds = 0.0;
+    for (const uint32_t threads : threadCounts) {
+        const RunResult result = measure(config, scalingInstances, threads);
+        if (threads == 1) {
+            singleThreadSeconds = result.totalSeconds;
+        }
+        const double eff = singleThreadSeconds / result.totalSeconds / threads;
+        printResult(result, budgetUs);
+        printf("        efficiency %.0f%%\n", eff * 100.0);
+        scaling.push_back(result);
+        efficiency.push_back(eff);
+    }
+
+    if (config.jsonPath) {
+        FILE* file = fopen(config.jsonPath, "w");
+        if (!file) {
+            fprintf(stderr, "[FatSatHost] Cannot open %s for writing\n", config.jsonPath);
+            return 2;
+        }
+        fprintf(file, "{\n  \"threads\": %u,\n  \"block_size\": %u,\n  \"sample_rate\": %.0f,\n"
+                      "  \"quality\": \"%s\",\n"
+                      "  \"budget_us\": %.2f,\n  \"instances_at_deadline\": %u,\n  \"ramp\": [\n",
+                config.threads, config.blockSize, config.sampleRate, kQualityNames[config.quality],
+                budgetUs, maxAtDeadline);
+        for (size_t i = 0; i < ramp.size(); ++i) {
+            writeResultJson(file, ramp[i], i + 1 == ramp.size());
+        }
+        fprintf(file, "  ],\n  \"scaling\": [\n");
+        for (size_t i = 0; i < scaling.size(); ++i) {
+            fprintf(file, "    {\"threads\": %u, \"efficiency\": %.3f}%s\n",
+                    scaling[i].threads, efficiency[i], i + 1 == scaling.size() ? "" : ",");
+        }
+        fprintf(file, "  ],\n  \"scaling_runs\": [\n");
+        for (size_t i = 0; i < scaling.size(); ++i) {
+            writeResultJson(file, scaling[i], i + 1 == scaling.size());
+        }
+        fprintf(file, "  ],\n  \"shared_tables\": {\"tables\": %zu, \"bytes\": %zu, "
+                      "\"references\": %zu, \"bytes_saved\": %zu}\n}\n",
+                tables.tables, tables.bytes, tables.references, tables.bytesSaved);
+        fclose(file);
+        printf("[FatSatHost] Wrote %s\n", config.jsonPath);
+    }
+
+    return 0;
+}
+
+END_NAMESPACE_DISTRHO
+
+int main(int argc, char** argv)
+{
+    DISTRHO_NAMESPACE::HostConfig config;
+    config.threads = std::max(1u, std::thread::hardware_concurrency());
+    config.blockSize = 128;
+    config.sampleRate = 48000.0;
+    config.seconds = 2.0;
+    config.maxInstances = 4096;
+    config.step = 8;
+    config.quality = DISTRHO_NAMESPACE::kQualityAuto;
+    config.jsonPath = nullptr;
+
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--threads") == 0 && hasValue) {
+            config.threads = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--block") == 0 && hasValue) {
+            config.blockSize = std::max(16, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--rate") == 0 && hasValue) {
+            config.sampleRate = std::max(8000.0, std::atof(argv[++i]));
+        } else if (std::strcmp(argv[i], "--seconds") == 0 && hasValue) {
+            config.seconds = std::max(0.1, std::atof(argv[++i]));
+        } else if (std::strcmp(argv[i], "--max-instances") == 0 && hasValue) {
+            config.maxInstances = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--step") == 0 && hasValue) {
+            config.step = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--quality") == 0 && hasValue) {
+            const char* name = argv[++i];
+            config.quality = 4;
+            for (uint32_t q = 0; q < 4; ++q) {
+                if (std::strcmp(name, DISTRHO_NAMESPACE::kQualityNames[q]) == 0) {
+                    config.quality = q;
+                }
+            }
+            if (config.quality == 4) {
+                fprintf(stderr, "[FatSatHost] Unknown quality '%s' (auto, eco, normal, hq)\n", name);
+                return 2;
+            }
+        } else if (std::strcmp(argv[i], "--json") == 0 && hasValue) {
+            config.jsonPath = argv[++i];
+        } else {
+            fprintf(stderr, "Usage: %s [--threads T] [--block N] [--rate HZ] [--seconds S]\n"
+                            "          [--max-instances N] [--step N] [--quality auto|eco|normal|hq]\n"
+                            "          [--json results.json]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    return DISTRHO_NAMESPACE::runHost(config);
+}
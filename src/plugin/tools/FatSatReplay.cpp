@@ -0,0 +1,517 @@
+/*
+ * FatSat Replay - Replays a recorded session as a performance benchmark
+ * Part of the Enlil/GodotVST Framework
+ *
+ * Reads a session log written with FATSAT_RECORD_SESSION (see
+ * src/shared/session_log.hpp) and drives FatSat from it without a host:
+ *
+ * - the DSP through DPF's PluginExporter, with the recorded audio and
+ *   parameter changes, timing every run() against its real-time budget
+ * - the Godot UI through GodotEngineHost and the editor's FrameBridge, with
+ *   the recorded input stream and resize requests, taking frames like the
+ *   DPF UI would (without drawing them)
+ *
+ * The UI replay runs in real time, records at their recorded offsets, so
+ * frame pacing matches the session; audio blocks are processed on the same
+ * thread when they come due. With --dsp-only the UI is skipped and the
+ * audio is processed as fast as possible.
+ *
+ * Reports DSP time (run() percentiles, load, overruns) and frame time
+ * (present-to-present percentiles, long frames, per-stage FrameBridge
+ * statistics of the last frames).
+ *
+ * Usage: fatsat_replay <session.log> [--dsp-only] [--display-driver NAME]
+ *                      [--json results.json]
+ *
+ * Run from the repository root (LibGodot and the project are found there).
+ */
+
+#include "DistrhoPluginInfo.h"
+
+// DPF plugin internals: PluginExporter and the d_next* creation globals
+#include "src/DistrhoPlugin.cpp"
+#if __has_include("src/DistrhoUtils.cpp")
+#include "src/DistrhoUtils.cpp"
+#endif
+
+#include "../FatSatPlugin.hpp"
+#include "../FatSatEngine.hpp"
+#include "../../shared/session_log.hpp"
+#include "../../shared/bench/bench.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+START_NAMESPACE_DISTRHO
+
+using enlil::bench::percentile;
+
+// How often the replayed "host" calls uiIdle()
+static constexpr uint64_t kUiIdleIntervalNs = 16000000;
+
+// Frames slower than this count as long (visible stutter)
+static constexpr double kLongFrameMs = 33.3;
+
+// Iterations to wait for the first frame before the timeline starts
+static constexpr int kMaxStartupIterations = 600;
+
+// UI idle time after the last record, so the final input gets rendered
+static constexpr uint64_t kTailNs = 500000000;
+
+struct ReplayConfig {
+    const char* logPath;
+    const char* displayDriver;
+    const char* jsonPath;
+    bool dspOnly;
+};
+
+struct ReplayResult {
+    uint64_t records[enlil::SESSION_AUDIO + 1];
+    double durationSeconds;
+
+    // DSP
+    uint64_t blocks;
+    uint64_t overruns;
+    double runP50Us;
+    double runP99Us;
+    double runMaxUs;
+    double loadP99;
+
+    // UI
+    uint64_t frames;
+    uint64_t longFrames;
+    double frameP50Ms;
+    double frameP99Ms;
+    double frameMaxMs;
+    double iterateP50Us;
+    double iterateP99Us;
+    enlil::FrameStats stats;
+};
+
+// Callbacks FatSat never uses, but PluginExporter wants
+static bool writeMidiCallback(void*, const MidiEvent&) { return false; }
+static bool requestParameterValueChangeCallback(void*, uint32_t, float) { return false; }
+static bool updateStateValueCallback(void*, const char*, const char*) { return false; }
+
+class Replayer {
+public:
+    Replayer(const ReplayConfig& config, enlil::SessionReader& reader)
+        : fConfig(config),
+          fReader(reader),
+          fSampleRate(48000.0),
+          fEditorId(0),
+          fBridge(nullptr),
+          fLastPresentNs(0)
+    {
+        std::memset(&fResult, 0, sizeof(fResult));
+    }
+
+    ~Replayer()
+    {
+        if (fPlugin) {
+            fPlugin->deactivate();
+        }
+        if (fEditorId != 0) {
+            GodotEngineHost::instance().release(fEditorId);
+        }
+    }
+
+    bool start()
+    {
+        // Block size and sample rate come from the recording
+        uint32_t maxFrames = 0;
+        double sampleRate = 0.0;
+        enlil::SessionRecordHeader header;
+        const uint8_t* payload;
+        while (fReader.next(header, payload)) {
+            if (header.type == enlil::SESSION_AUDIO) {
+                enlil::SessionAudio audio;
+                std::memcpy(&audio, payload, sizeof(audio));
+                maxFrames = std::max(maxFrames, audio.frames);
+                if (sampleRate == 0.0) {
+                    sampleRate = audio.sampleRate;
+                }
+            }
+        }
+        fReader.rewind();
+
+        if (maxFrames == 0) {
+            maxFrames = 512;
+            sampleRate = 48000.0;
+            fprintf(stderr, "[Replay] Session has no audio, only replaying the UI\n");
+        }
+
+        d_nextBufferSize = maxFrames;
+        d_nextSampleRate = sampleRate;
+        fPlugin.reset(new PluginExporter(this,
+                                         writeMidiCallback,
+                                         requestParameterValueChangeCallback,
+                                         updateStateValueCallback));
+        fPlugin->activate();
+        fSampleRate = sampleRate;
+
+        for (int channel = 0; channel < DISTRHO_PLUGIN_NUM_OUTPUTS; ++channel) {
+            fOutput[channel].resize(maxFrames);
+        }
+
+        return fConfig.dspOnly || startEngine();
+    }
+
+    void run()
+    {
+        const uint64_t timelineStart = enlil::hostTimeNs();
+        uint64_t nextIdleNs = timelineStart;
+        uint64_t lastRecordNs = 0;
+
+        enlil::SessionRecordHeader header;
+        const uint8_t* payload;
+        while (fReader.next(header, payload)) {
+            if (!fConfig.dspOnly) {
+                const uint64_t dueNs = timelineStart + header.timeNs;
+                waitUntil(dueNs, nextIdleNs);
+            }
+            apply(header, payload);
+            lastRecordNs = header.timeNs;
+        }
+
+        if (!fConfig.dspOnly) {
+            waitUntil(enlil::hostTimeNs() + kTailNs, nextIdleNs);
+        }
+
+        fResult.durationSeconds = lastRecordNs / 1.0e9;
+        summarize();
+    }
+
+    const ReplayResult& getResult() const { return fResult; }
+
+private:
+    bool startEngine()
+    {
+        GodotEngineHost& engine = GodotEngineHost::instance();
+        engine.setDisplayDriver(fConfig.displayDriver);
+        engine.setKeepWarm(false);
+
+        fEditorId = engine.acquire();
+        fBridge = enlil::FrameBridge::forEditor(fEditorId);
+
+        while (!engine.isRunning() && !engine.hasFailed()) {
+            engine.advanceStartup();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        if (engine.hasFailed() || !fBridge) {
+            fprintf(stderr, "[Replay] Godot engine failed to start\n");
+            return false;
+        }
+
+        // The timeline starts once the editor shows its first frame
+        for (int i = 0; i < kMaxStartupIterations; ++i) {
+            engine.iterate();
+            if (fBridge->hasNewFrame()) {
+                fBridge->resetFrameStats();
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(
+                GodotEngineHost::kDefaultMinIterationIntervalNs / 1000000));
+        }
+
+        fprintf(stderr, "[Replay] No frame from the editor after %d iterations\n", kMaxStartupIterations);
+        return false;
+    }
+
+    // Keep the UI idling until dueNs
+    void waitUntil(uint64_t dueNs, uint64_t& nextIdleNs)
+    {
+        for (;;) {
+            const uint64_t now = enlil::hostTimeNs();
+            if (now >= nextIdleNs) {
+                idle();
+                nextIdleNs += kUiIdleIntervalNs;
+                continue;
+            }
+            if (now >= dueNs) {
+                return;
+            }
+            const uint64_t sleepNs = std::min(dueNs, nextIdleNs) - now;
+            std::this_thread::sleep_for(std::chrono::nanoseconds(sleepNs));
+        }
+    }
+
+    // What FatSatUI::uiIdle() and onDisplay() do, minus the GL upload
+    void idle()
+    {
+        fBridge->flushInputEvents();
+
+        const uint64_t start = enlil::hostTimeNs();
+        GodotEngineHost::instance().iterate();
+        const uint64_t end = enlil::hostTimeNs();
+        fIterateUs.push_back((end - start) / 1000.0);
+
+        if (fBridge->hasNewFrame()) {
+            fBridge->markFrameUploaded();
+            fBridge->markFramePresented();
+
+            if (fLastPresentNs != 0) {
+                fFrameMs.push_back((end - fLastPresentNs) / 1.0e6);
+            }
+            fLastPresentNs = end;
+        }
+    }
+
+    void apply(const enlil::SessionRecordHeader& header, const uint8_t* payload)
+    {
+        if (header.type <= enlil::SESSION_AUDIO) {
+            fResult.records[header.type]++;
+        }
+
+        switch (header.type) {
+        case enlil::SESSION_INPUT:
+            if (fBridge) {
+                enlil::SessionInput input;
+                std::memcpy(&input, payload, sizeof(input));
+                fBridge->pushInputEvent(enlil::fromSessionInput(input, enlil::hostTimeNs()));
+            }
+            break;
+
+        case enlil::SESSION_RESIZE:
+            if (fBridge) {
+                enlil::SessionResize resize;
+                std::memcpy(&resize, payload, sizeof(resize));
+                fBridge->setRequestedSize(resize.width, resize.height);
+            }
+            break;
+
+        case enlil::SESSION_PARAMETER: {
+            enlil::SessionParameter parameter;
+            std::memcpy(&parameter, payload, sizeof(parameter));
+            if (parameter.index < fPlugin->getParameterCount() && !fPlugin->isParameterOutput(parameter.index)) {
+                fPlugin->setParameterValue(parameter.index, parameter.value);
+            }
+            break;
+        }
+
+        case enlil::SESSION_AUDIO:
+            processAudio(payload);
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    void processAudio(const uint8_t* payload)
+    {
+        enlil::SessionAudio audio;
+        std::memcpy(&audio, payload, sizeof(audio));
+        if (audio.frames == 0) {
+            return;
+        }
+
+        // Planar channels follow the header; copy them out for alignment
+        const float* inputs[DISTRHO_PLUGIN_NUM_INPUTS];
+        for (uint32_t channel = 0; channel < DISTRHO_PLUGIN_NUM_INPUTS; ++channel) {
+            std::vector<float>& input = fInput[channel];
+            input.assign(audio.frames, 0.0f);
+            if (channel < audio.channels) {
+                std::memcpy(input.data(), payload + sizeof(audio) + channel * audio.frames * sizeof(float),
+                            audio.frames * sizeof(float));
+            }
+            inputs[channel] = input.data();
+        }
+
+        float* outputs[DISTRHO_PLUGIN_NUM_OUTPUTS];
+        for (uint32_t channel = 0; channel < DISTRHO_PLUGIN_NUM_OUTPUTS; ++channel) {
+            outputs[channel] = fOutput[channel].data();
+        }
+
+        const uint64_t start = enlil::hostTimeNs();
+        fPlugin->run(inputs, outputs, audio.frames);
+        const double runNs = static_cast<double>(enlil::hostTimeNs() - start);
+
+        const double budgetNs = audio.frames / fSampleRate * 1.0e9;
+        fRunUs.push_back(runNs / 1000.0);
+        fLoad.push_back(runNs / budgetNs * 100.0);
+        if (runNs > budgetNs) {
+            fResult.overruns++;
+        }
+    }
+
+    void summarize()
+    {
+        fResult.blocks = fRunUs.size();
+        fResult.runP50Us = percentile(fRunUs, 50.0);
+        fResult.runP99Us = percentile(fRunUs, 99.0);
+        fResult.runMaxUs = fRunUs.empty() ? 0.0 : *std::max_element(fRunUs.begin(), fRunUs.end());
+        fResult.loadP99 = percentile(fLoad, 99.0);
+
+        fResult.frames = fFrameMs.size();
+        fResult.longFrames = static_cast<uint64_t>(std::count_if(fFrameMs.begin(), fFrameMs.end(),
+            [](double ms) { return ms > kLongFrameMs; }));
+        fResult.frameP50Ms = percentile(fFrameMs, 50.0);
+        fResult.frameP99Ms = percentile(fFrameMs, 99.0);
+        fResult.frameMaxMs = fFrameMs.empty() ? 0.0 : *std::max_element(fFrameMs.begin(), fFrameMs.end());
+        fResult.iterateP50Us = percentile(fIterateUs, 50.0);
+        fResult.iterateP99Us = percentile(fIterateUs, 99.0);
+
+        if (fBridge) {
+            fBridge->getFrameStats(fResult.stats);
+        }
+    }
+
+    const ReplayConfig& fConfig;
+    enlil::SessionReader& fReader;
+
+    std::unique_ptr<PluginExporter> fPlugin;
+    double fSampleRate;
+    std::vector<float> fInput[DISTRHO_PLUGIN_NUM_INPUTS];
+    std::vector<float> fOutput[DISTRHO_PLUGIN_NUM_OUTPUTS];
+
+    uint32_t fEditorId;
+    enlil::FrameBridge* fBridge;
+    uint64_t fLastPresentNs;
+
+    std::vector<double> fRunUs;
+    std::vector<double> fLoad;
+    std::vector<double> fFrameMs;
+    std::vector<double> fIterateUs;
+    ReplayResult fResult;
+};
+
+// === Output ===
+
+static void printResult(const ReplayConfig& config, const ReplayResult& result)
+{
+    printf("Session %s: %.1f s, %llu input, %llu resize, %llu parameter, %llu audio records\n",
+           config.logPath, result.durationSeconds,
+           (unsigned long long)result.records[enlil::SESSION_INPUT],
+           (unsigned long long)result.records[enlil::SESSION_RESIZE],
+           (unsigned long long)result.records[enlil::SESSION_PARAMETER],
+           (unsigned long long)result.records[enlil::SESSION_AUDIO]);
+
+    printf("DSP: %llu blocks, run p50 %.1f us, p99 %.1f us, max %.1f us, load p99 %.1f%%, overruns %llu\n",
+           (unsigned long long)result.blocks, result.runP50Us, result.runP99Us, result.runMaxUs,
+           result.loadP99, (unsigned long long)result.overruns);
+
+    if (config.dspOnly) {
+        return;
+    }
+
+    printf("UI: %llu frames, frame p50 %.1f ms, p99 %.1f ms, max %.1f ms, %llu over %.1f ms\n",
+           (unsigned long long)result.frames, result.frameP50Ms, result.frameP99Ms, result.frameMaxMs,
+           (unsigned long long)result.longFrames, kLongFrameMs);
+    printf("    iterate p50 %.1f us, p99 %.1f us; dropped %llu, skipped %llu\n",
+           result.iterateP50Us, result.iterateP99Us,
+           (unsigned long long)result.stats.droppedFrames, (unsigned long long)result.stats.skippedFrames);
+    for (int stage = 0; stage < enlil::FRAME_STAGE_COUNT; ++stage) {
+        const enlil::FramePercentiles& p = result.stats.stages[stage];
+        printf("    %-10s p50 %8.1f us  p99 %8.1f us\n",
+               enlil::frameStageName(static_cast<enlil::FrameStage>(stage)), p.p50Us, p.p99Us);
+    }
+}
+
+static bool writeJson(const ReplayConfig& config, const ReplayResult& result)
+{
+    FILE* file = fopen(config.jsonPath, "w");
+    if (!file) {
+        fprintf(stderr, "[Replay] Cannot open %s for writing\n", config.jsonPath);
+        return false;
+    }
+
+    fprintf(file, "{\n  \"session\": \"%s\",\n  \"duration_s\": %.3f,\n", config.logPath, result.durationSeconds);
+    fprintf(file, "  \"records\": {\"input\": %llu, \"resize\": %llu, \"parameter\": %llu, \"audio\": %llu},\n",
+            (unsigned long long)result.records[enlil::SESSION_INPUT],
+            (unsigned long long)result.records[enlil::SESSION_RESIZE],
+            (unsigned long long)result.records[enlil::SESSION_PARAMETER],
+            (unsigned long long)result.records[enlil::SESSION_AUDIO]);
+    fprintf(file, "  \"dsp\": {\"blocks\": %llu, \"run_p50_us\": %.2f, \"run_p99_us\": %.2f, "
+                  "\"run_max_us\": %.2f, \"load_p99\": %.2f, \"overruns\": %llu}",
+            (unsigned long long)result.blocks, result.runP50Us, result.runP99Us, result.runMaxUs,
+            result.loadP99, (unsigned long long)result.overruns);
+
+    if (!config.dspOnly) {
+        fprintf(file, ",\n  \"ui\": {\n    \"frames\": %llu, \"long_frames\": %llu,\n"
+                      "    \"frame_p50_ms\": %.2f, \"frame_p99_ms\": %.2f, \"frame_max_ms\": %.2f,\n"
+                      "    \"iterate_p50_us\": %.2f, \"iterate_p99_us\": %.2f,\n"
+                      "    \"dropped\": %llu, \"skipped\": %llu,\n    \"stages\": {\n",
+                (unsigned long long)result.frames, (unsigned long long)result.longFrames,
+                result.frameP50Ms, result.frameP99Ms, result.frameMaxMs,
+                result.iterateP50Us, result.iterateP99Us,
+                (unsigned long long)result.stats.droppedFrames, (unsigned long long)result.stats.skippedFrames);
+        for (int stage = 0; stage < enlil::FRAME_STAGE_COUNT; ++stage) {
+            const enlil::FramePercentiles& p = result.stats.stages[stage];
+            fprintf(file, "      \"%s\": {\"p50_us\": %.2f, \"p95_us\": %.2f, \"p99_us\": %.2f}%s\n",
+                    enlil::frameStageName(static_cast<enlil::FrameStage>(stage)),
+                    p.p50Us, p.p95Us, p.p99Us, stage + 1 < enlil::FRAME_STAGE_COUNT ? "," : "");
+        }
+        fprintf(file, "    }\n  }");
+    }
+
+    fprintf(file, "\n}\n");
+    fclose(file);
+    return true;
+}
+
+static int runReplay(const ReplayConfig& config)
+{
+    enlil::SessionReader reader;
+    if (!reader.open(config.logPath)) {
+        return 1;
+    }
+
+    ReplayResult result;
+    {
+        Replayer replayer(config, reader);
+        if (!replayer.start()) {
+            return 1;
+        }
+        replayer.run();
+        result = replayer.getResult();
+    }
+
+    printResult(config, result);
+
+    if (config.jsonPath && !writeJson(config, result)) {
+        return 1;
+    }
+    return 0;
+}
+
+END_NAMESPACE_DISTRHO
+
+int main(int argc, char** argv)
+{
+    DISTRHO_NAMESPACE::ReplayConfig config;
+    config.logPath = nullptr;
+    config.displayDriver = nullptr;
+    config.jsonPath = nullptr;
+    config.dspOnly = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--dsp-only") == 0) {
+            config.dspOnly = true;
+        } else if (std::strcmp(argv[i], "--display-driver") == 0 && hasValue) {
+            config.displayDriver = argv[++i];
+        } else if (std::strcmp(argv[i], "--json") == 0 && hasValue) {
+            config.jsonPath = argv[++i];
+        } else if (argv[i][0] != '-' && !config.logPath) {
+            config.logPath = argv[i];
+        } else {
+            config.logPath = nullptr;
+            break;
+        }
+    }
+
+    if (!config.logPath) {
+        fprintf(stderr, "Usage: %s <session.log> [--dsp-only] [--display-driver NAME]\n"
+                        "          [--json results.json]\n", argv[0]);
+        return 2;
+    }
+
+    return DISTRHO_NAMESPACE::runReplay(config);
+}
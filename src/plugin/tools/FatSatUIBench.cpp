@@ -0,0 +1,533 @@
+/*
+ * FatSat UI Bench - Offscreen benchmark of the Godot → host frame pipeline
+ * Part of the Enlil/GodotVST Framework
+ *
+ * Runs the FatSat editor scene through the same code the plugin uses
+ * (GodotEngineHost, FrameExporter, FrameBridge, FrameBlitter) without an
+ * X server, so the UI pipeline can be measured on CI machines.
+ *
+ * The host side draws into a framebuffer object of a surfaceless EGL
+ * context (EGL_MESA_platform_surfaceless), in place of DPF's window. Godot
+ * has no surfaceless display server (its headless driver uses a dummy
+ * renderer that draws nothing), so it runs on its Wayland display driver,
+ * which renders through EGL; point WAYLAND_DISPLAY at a headless compositor,
+ * e.g. `weston --backend=headless-backend.so`. LibGodot must be built with
+ * Wayland support.
+ *
+ * For every size, the editor is resized, given time to settle, and then
+ * driven for N frames with the engine unthrottled. Reports per-stage
+ * percentiles from FrameBridge::getFrameStats() plus the wall time of the
+ * engine iteration and of the host-side upload + draw.
+ *
+ * Usage: fatsat_ui_bench [--frames N] [--warmup N] [--sizes WxH,WxH,...]
+ *                        [--display-driver NAME] [--json results.json]
+ *
+ * Run from the repository root (LibGodot and the project are found there).
+ */
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include "../FatSatEngine.hpp"
+#include "../FatSatBlitter.hpp"
+#include "../../shared/frame_bridge.hpp"
+#include "../../shared/bench/bench.hpp"
+
+#include <GL/gl.h>
+#include <GL/glext.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+START_NAMESPACE_DISTRHO
+
+using enlil::bench::percentile;
+
+// Frames to wait for the first exported frame / a resize to reach the host
+static constexpr int kMaxSettleFrames = 600;
+
+struct BenchConfig {
+    int frames;
+    int warmup;
+    std::vector<std::pair<int, int>> sizes;
+    const char* displayDriver;
+    const char* jsonPath;
+};
+
+struct SizeResult {
+    int width;
+    int height;
+    int uploadedFrames;
+    double iterateP50Us;
+    double iterateP99Us;
+    double blitP50Us;
+    double blitP99Us;
+    enlil::FrameStats stats;
+};
+
+// === Surfaceless EGL context with a framebuffer object as render target ===
+
+class OffscreenTarget {
+public:
+    OffscreenTarget()
+        : fDisplay(EGL_NO_DISPLAY),
+          fContext(EGL_NO_CONTEXT),
+          fFramebuffer(0),
+          fRenderbuffer(0),
+          fGenFramebuffers(nullptr),
+          fDeleteFramebuffers(nullptr),
+          fBindFramebuffer(nullptr),
+          fFramebufferRenderbuffer(nullptr),
+          fCheckFramebufferStatus(nullptr),
+          fGenRenderbuffers(nullptr),
+          fDeleteRenderbuffers(nullptr),
+          fBindRenderbuffer(nullptr),
+          fRenderbufferStorage(nullptr)
+    {}
+
+    ~OffscreenTarget()
+    {
+        if (fContext != EGL_NO_CONTEXT) {
+            makeCurrent();
+            destroyFramebuffer();
+            eglMakeCurrent(fDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+            eglDestroyContext(fDisplay, fContext);
+        }
+        if (fDisplay != EGL_NO_DISPLAY) {
+            eglTerminate(fDisplay);
+        }
+    }
+
+    bool init()
+    {
+        PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+            reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+                eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        if (!getPlatformDisplay) {
+            fprintf(stderr, "[UIBench] eglGetPlatformDisplayEXT not available\n");
+            return false;
+        }
+
+        fDisplay = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+        if (fDisplay == EGL_NO_DISPLAY || !eglInitialize(fDisplay, nullptr, nullptr)) {
+            fprintf(stderr, "[UIBench] No surfaceless EGL display (needs EGL_MESA_platform_surfaceless)\n");
+            fDisplay = EGL_NO_DISPLAY;
+            return false;
+        }
+
+        // Desktop GL: the blitter uses the compatibility profile like DPF
+        if (!eglBindAPI(EGL_OPENGL_API)) {
+            fprintf(stderr, "[UIBench] eglBindAPI(EGL_OPENGL_API) failed\n");
+            return false;
+        }
+
+        const EGLint configAttribs[] = {
+            EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+            EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+            EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8, EGL_ALPHA_SIZE, 8,
+            EGL_NONE
+        };
+        EGLConfig config = nullptr;
+        EGLint configCount = 0;
+        if (!eglChooseConfig(fDisplay, configAttribs, &config, 1, &configCount) || configCount == 0) {
+            // Surfaceless contexts work without a config on Mesa
+            config = nullptr;
+        }
+
+        fContext = eglCreateContext(fDisplay, config, EGL_NO_CONTEXT, nullptr);
+        if (fContext == EGL_NO_CONTEXT) {
+            fprintf(stderr, "[UIBench] eglCreateContext failed: 0x%x\n", eglGetError());
+            return false;
+        }
+
+        if (!makeCurrent()) {
+            fprintf(stderr, "[UIBench] Surfaceless eglMakeCurrent failed: 0x%x\n", eglGetError());
+            return false;
+        }
+
+        return loadFramebufferFunctions();
+    }
+
+    bool makeCurrent()
+    {
+        return eglMakeCurrent(fDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, fContext) == EGL_TRUE;
+    }
+
+    // (Re)create the color target at the given size and bind it
+    bool resize(int width, int height)
+    {
+        destroyFramebuffer();
+
+        fGenRenderbuffers(1, &fRenderbuffer);
+        fBindRenderbuffer(GL_RENDERBUFFER, fRenderbuffer);
+        fRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+
+        fGenFramebuffers(1, &fFramebuffer);
+        fBindFramebuffer(GL_FRAMEBUFFER, fFramebuffer);
+        fFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, fRenderbuffer);
+
+        if (fCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            fprintf(stderr, "[UIBench] Framebuffer %dx%d incomplete\n", width, height);
+            return false;
+        }
+        return true;
+    }
+
+    void bind()
+    {
+        fBindFramebuffer(GL_FRAMEBUFFER, fFramebuffer);
+    }
+
+private:
+    template<typename T>
+    static bool load(T& function, const char* name)
+    {
+        function = reinterpret_cast<T>(eglGetProcAddress(name));
+        if (!function) {
+            fprintf(stderr, "[UIBench] Missing GL function %s\n", name);
+        }
+        return function != nullptr;
+    }
+
+    bool loadFramebufferFunctions()
+    {
+        return load(fGenFramebuffers, "glGenFramebuffers")
+            && load(fDeleteFramebuffers, "glDeleteFramebuffers")
+            && load(fBindFramebuffer, "glBindFramebuffer")
+            && load(fFramebufferRenderbuffer, "glFramebufferRenderbuffer")
+            && load(fCheckFramebufferStatus, "glCheckFramebufferStatus")
+            && load(fGenRenderbuffers, "glGenRenderbuffers")
+            && load(fDeleteRenderbuffers, "glDeleteRenderbuffers")
+            && load(fBindRenderbuffer, "glBindRenderbuffer")
+            && load(fRenderbufferStorage, "glRenderbufferStorage");
+    }
+
+    void destroyFramebuffer()
+    {
+        if (fFramebuffer != 0) {
+            fBindFramebuffer(GL_FRAMEBUFFER, 0);
+            fDeleteFramebuffers(1, &fFramebuffer);
+            fFramebuffer = 0;
+        }
+        if (fRenderbuffer != 0) {
+            fDeleteRenderbuffers(1, &fRenderbuffer);
+            fRenderbuffer = 0;
+        }
+    }
+
+    EGLDisplay fDisplay;
+    EGLContext fContext;
+    GLuint fFramebuffer;
+    GLuint fRenderbuffer;
+
+    PFNGLGENFRAMEBUFFERSPROC fGenFramebuffers;
+    PFNGLDELETEFRAMEBUFFERSPROC fDeleteFramebuffers;
+    PFNGLBINDFRAMEBUFFERPROC fBindFramebuffer;
+    PFNGLFRAMEBUFFERRENDERBUFFERPROC fFramebufferRenderbuffer;
+    PFNGLCHECKFRAMEBUFFERSTATUSPROC fCheckFramebufferStatus;
+    PFNGLGENRENDERBUFFERSPROC fGenRenderbuffers;
+    PFNGLDELETERENDERBUFFERSPROC fDeleteRenderbuffers;
+    PFNGLBINDRENDERBUFFERPROC fBindRenderbuffer;
+    PFNGLRENDERBUFFERSTORAGEPROC fRenderbufferStorage;
+};
+
+// === Benchmark ===
+
+class UIBench {
+public:
+    explicit UIBench(const BenchConfig& config)
+        : fConfig(config),
+          fEngine(GodotEngineHost::instance()),
+          fEditorId(0),
+          fBridge(nullptr)
+    {}
+
+    ~UIBench()
+    {
+        if (fEditorId != 0) {
+            fTarget.makeCurrent();
+            fBlitter.cleanup();
+            fEngine.release(fEditorId);
+        }
+    }
+
+    bool start()
+    {
+        if (!fTarget.init()) {
+            return false;
+        }
+
+        fEngine.setDisplayDriver(fConfig.displayDriver);
+        fEngine.setMinIterationInterval(0);
+        fEngine.setKeepWarm(false);
+
+        const uint64_t bootStart = enlil::hostTimeNs();
+        fEditorId = fEngine.acquire();
+        fBridge = enlil::FrameBridge::forEditor(fEditorId);
+
+        while (!fEngine.isRunning() && !fEngine.hasFailed()) {
+            fEngine.advanceStartup();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        if (fEngine.hasFailed() || !fBridge) {
+            fprintf(stderr, "[UIBench] Godot engine failed to start\n");
+            return false;
+        }
+
+        fprintf(stdout, "[UIBench] Engine running after %.1f ms\n",
+                (enlil::hostTimeNs() - bootStart) / 1.0e6);
+
+        fTarget.makeCurrent();
+        fBlitter.init();
+        fBridge->setResizeSettleTime(0);
+        return true;
+    }
+
+    bool runSize(int width, int height, SizeResult& result)
+    {
+        fTarget.makeCurrent();
+        if (!fTarget.resize(width, height)) {
+            return false;
+        }
+
+        // Let the editor re-render at the new size before measuring
+        fBridge->setRequestedSize(width, height);
+        int settled = 0;
+        for (int i = 0; i < kMaxSettleFrames && settled < fConfig.warmup; ++i) {
+            if (frame(width, height) && fBlitter.getFrameWidth() == width
+                                      && fBlitter.getFrameHeight() == height) {
+                settled++;
+            }
+        }
+        if (settled < fConfig.warmup) {
+            fprintf(stderr, "[UIBench] No %dx%d frames after %d iterations\n",
+                    width, height, kMaxSettleFrames);
+            return false;
+        }
+
+        fBridge->resetFrameStats();
+
+        std::vector<double> iterateUs;
+        std::vector<double> blitUs;
+        iterateUs.reserve(fConfig.frames);
+        blitUs.reserve(fConfig.frames);
+
+        result.width = width;
+        result.height = height;
+        result.uploadedFrames = 0;
+
+        for (int i = 0; i < fConfig.frames; ++i) {
+            double iterationUs = 0.0;
+            double drawUs = 0.0;
+            if (frame(width, height, &iterationUs, &drawUs)) {
+                result.uploadedFrames++;
+            }
+            iterateUs.push_back(iterationUs);
+            blitUs.push_back(drawUs);
+        }
+
+        result.iterateP50Us = percentile(iterateUs, 50.0);
+        result.iterateP99Us = percentile(iterateUs, 99.0);
+        result.blitP50Us = percentile(blitUs, 50.0);
+        result.blitP99Us = percentile(blitUs, 99.0);
+        fBridge->getFrameStats(result.stats);
+        return true;
+    }
+
+private:
+    // One engine iteration plus what FatSatUI::onDisplay() does
+    // Returns true if a new frame was uploaded
+    bool frame(int width, int height, double* iterationUs = nullptr, double* drawUs = nullptr)
+    {
+        const uint64_t t0 = enlil::hostTimeNs();
+        fEngine.iterate();
+        const uint64_t t1 = enlil::hostTimeNs();
+
+        fTarget.makeCurrent();
+        fTarget.bind();
+        glViewport(0, 0, width, height);
+
+        const bool uploaded = fBlitter.upload(*fBridge);
+
+        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        if (fBlitter.hasFrame()) {
+            fBlitter.draw(width, height);
+        }
+
+        // No swap to wait for; finish so the draw is part of the measurement
+        glFinish();
+        if (fBlitter.hasFrame()) {
+            fBridge->markFramePresented();
+        }
+        const uint64_t t2 = enlil::hostTimeNs();
+
+        if (iterationUs) *iterationUs = (t1 - t0) / 1000.0;
+        if (drawUs) *drawUs = (t2 - t1) / 1000.0;
+        return uploaded;
+    }
+
+    const BenchConfig& fConfig;
+    GodotEngineHost& fEngine;
+    OffscreenTarget fTarget;
+    FrameBlitter fBlitter;
+    uint32_t fEditorId;
+    enlil::FrameBridge* fBridge;
+};
+
+// === Output ===
+
+static void printResult(const SizeResult& result)
+{
+    const enlil::FrameStats& stats = result.stats;
+
+    printf("\n%dx%d: %u frames in ring, %d uploaded, %.1f fps, dropped %llu, skipped %llu\n",
+           result.width, result.height, stats.frameCount, result.uploadedFrames, stats.fps,
+           (unsigned long long)stats.droppedFrames, (unsigned long long)stats.skippedFrames);
+    printf("  %-10s %10s %10s %10s\n", "stage", "p50 us", "p95 us", "p99 us");
+    for (int stage = 0; stage < enlil::FRAME_STAGE_COUNT; ++stage) {
+        const enlil::FramePercentiles& p = stats.stages[stage];
+        printf("  %-10s %10.1f %10.1f %10.1f\n",
+               enlil::frameStageName(static_cast<enlil::FrameStage>(stage)),
+               p.p50Us, p.p95Us, p.p99Us);
+    }
+    printf("  %-10s %10.1f %10.1f %10.1f\n", "age", stats.age.p50Us, stats.age.p95Us, stats.age.p99Us);
+    printf("  iterate    p50 %.1f us, p99 %.1f us\n", result.iterateP50Us, result.iterateP99Us);
+    printf("  blit       p50 %.1f us, p99 %.1f us\n", result.blitP50Us, result.blitP99Us);
+}
+
+static void writePercentiles(FILE* file, const char* name, const enlil::FramePercentiles& p, bool last)
+{
+    fprintf(file, "        \"%s\": {\"p50_us\": %.2f, \"p95_us\": %.2f, \"p99_us\": %.2f}%s\n",
+            name, p.p50Us, p.p95Us, p.p99Us, last ? "" : ",");
+}
+
+static bool writeJson(const char* path, const BenchConfig& config, const std::vector<SizeResult>& results)
+{
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        fprintf(stderr, "[UIBench] Cannot open %s for writing\n", path);
+        return false;
+    }
+
+    fprintf(file, "{\n  \"frames\": %d,\n  \"display_driver\": \"%s\",\n  \"sizes\": [\n",
+            config.frames, config.displayDriver ? config.displayDriver : "default");
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const SizeResult& result = results[i];
+        const enlil::FrameStats& stats = result.stats;
+
+        fprintf(file, "    {\n      \"width\": %d, \"height\": %d,\n", result.width, result.height);
+        fprintf(file, "      \"fps\": %.2f, \"presented\": %u, \"uploaded\": %d, \"dropped\": %llu, \"skipped\": %llu,\n",
+                stats.fps, stats.frameCount, result.uploadedFrames,
+                (unsigned long long)stats.droppedFrames, (unsigned long long)stats.skippedFrames);
+        fprintf(file, "      \"iterate_us\": {\"p50\": %.2f, \"p99\": %.2f},\n",
+                result.iterateP50Us, result.iterateP99Us);
+        fprintf(file, "      \"blit_us\": {\"p50\": %.2f, \"p99\": %.2f},\n",
+                result.blitP50Us, result.blitP99Us);
+        fprintf(file, "      \"stages\": {\n");
+        for (int stage = 0; stage < enlil::FRAME_STAGE_COUNT; ++stage) {
+            writePercentiles(file, enlil::frameStageName(static_cast<enlil::FrameStage>(stage)),
+                             stats.stages[stage], false);
+        }
+        writePercentiles(file, "age", stats.age, true);
+        fprintf(file, "      }\n    }%s\n", i + 1 < results.size() ? "," : "");
+    }
+
+    fprintf(file, "  ]\n}\n");
+    fclose(file);
+    return true;
+}
+
+// === Command line ===
+
+static bool parseSizes(const char* text, std::vector<std::pair<int, int>>& sizes)
+{
+    sizes.clear();
+    std::string list(text);
+    size_t start = 0;
+    while (start <= list.size()) {
+        const size_t end = std::min(list.find(',', start), list.size());
+        int width = 0;
+        int height = 0;
+        if (sscanf(list.substr(start, end - start).c_str(), "%dx%d", &width, &height) != 2
+            || width <= 0 || height <= 0) {
+            return false;
+        }
+        sizes.emplace_back(width, height);
+        start = end + 1;
+    }
+    return !sizes.empty();
+}
+
+static void printUsage(const char* program)
+{
+    fprintf(stderr,
+            "Usage: %s [--frames N] [--warmup N] [--sizes WxH,WxH,...]\n"
+            "          [--display-driver NAME] [--json results.json]\n",
+            program);
+}
+
+END_NAMESPACE_DISTRHO
+
+int main(int argc, char** argv)
+{
+    USE_NAMESPACE_DISTRHO
+
+    BenchConfig config;
+    config.frames = 600;
+    config.warmup = 30;
+    config.sizes = {{400, 300}, {800, 600}, {1280, 960}};
+    config.displayDriver = "wayland";
+    config.jsonPath = nullptr;
+
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--frames") == 0 && hasValue) {
+            config.frames = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--warmup") == 0 && hasValue) {
+            config.warmup = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--sizes") == 0 && hasValue) {
+            if (!parseSizes(argv[++i], config.sizes)) {
+                fprintf(stderr, "[UIBench] Invalid size list: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--display-driver") == 0 && hasValue) {
+            config.displayDriver = argv[++i];
+        } else if (std::strcmp(argv[i], "--json") == 0 && hasValue) {
+            config.jsonPath = argv[++i];
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::vector<SizeResult> results;
+    {
+        UIBench bench(config);
+        if (!bench.start()) {
+            return 1;
+        }
+
+        for (const std::pair<int, int>& size : config.sizes) {
+            SizeResult result;
+            if (!bench.runSize(size.first, size.second, result)) {
+                return 1;
+            }
+            printResult(result);
+            results.push_back(result);
+        }
+    }
+
+    if (config.jsonPath && !writeJson(config.jsonPath, config, results)) {
+        return 1;
+    }
+
+    return 0;
+}
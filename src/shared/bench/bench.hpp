@@ -0,0 +1,122 @@
+/*
+ * Bench - Minimal benchmark harness for the bridge primitives
+ * Part of the Enlil/GodotVST Framework
+ *
+ * Collects named results with a threshold each, prints a table and writes
+ * them as JSON. A result fails when it is worse than its threshold; the
+ * suite exit code reports whether any did.
+ */
+
+#ifndef ENLIL_BENCH_HPP
+#define ENLIL_BENCH_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace enlil {
+namespace bench {
+
+inline uint64_t nowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Keep a value alive so the computation producing it is not optimized out
+template<typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Nearest-rank percentile (reorders samples)
+inline double percentile(std::vector<double>& samples, double percent) {
+    if (samples.empty()) {
+        return 0.0;
+    }
+    const size_t rank = static_cast<size_t>(samples.size() * percent / 100.0 + 0.999999);
+    const size_t index = std::min(samples.size() - 1, rank > 0 ? rank - 1 : 0);
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+enum Direction {
+    LOWER_IS_BETTER,  // times, latencies, losses
+    HIGHER_IS_BETTER  // throughput
+};
+
+struct Result {
+    std::string name;
+    std::string unit;
+    double value;
+    double threshold;
+    Direction direction;
+
+    bool passed() const {
+        return direction == LOWER_IS_BETTER ? value <= threshold : value >= threshold;
+    }
+};
+
+class Suite {
+public:
+    explicit Suite(const char* name) : fName(name) {}
+
+    void add(const std::string& name, const char* unit, double value,
+             double threshold, Direction direction = LOWER_IS_BETTER) {
+        fResults.push_back({name, unit, value, threshold, direction});
+        const Result& result = fResults.back();
+        printf("  %-44s %14.2f %-8s %s %12.2f  %s\n",
+               result.name.c_str(), result.value, unit,
+               direction == LOWER_IS_BETTER ? "<=" : ">=", threshold,
+               result.passed() ? "ok" : "FAIL");
+        fflush(stdout);
+    }
+
+    bool passed() const {
+        for (const Result& result : fResults) {
+            if (!result.passed()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    size_t failureCount() const {
+        return static_cast<size_t>(std::count_if(fResults.begin(), fResults.end(),
+            [](const Result& result) { return !result.passed(); }));
+    }
+
+    bool writeJson(const char* path) const {
+        FILE* file = fopen(path, "w");
+        if (!file) {
+            fprintf(stderr, "[Bench] Cannot open %s for writing\n", path);
+            return false;
+        }
+
+        fprintf(file, "{\n  \"suite\": \"%s\",\n  \"passed\": %s,\n  \"results\": [\n",
+                fName.c_str(), passed() ? "true" : "false");
+        for (size_t i = 0; i < fResults.size(); ++i) {
+            const Result& result = fResults[i];
+            fprintf(file, "    {\"name\": \"%s\", \"unit\": \"%s\", \"value\": %.4f, "
+                          "\"threshold\": %.4f, \"direction\": \"%s\", \"passed\": %s}%s\n",
+                    result.name.c_str(), result.unit.c_str(), result.value, result.threshold,
+                    result.direction == LOWER_IS_BETTER ? "lower" : "higher",
+                    result.passed() ? "true" : "false",
+                    i + 1 < fResults.size() ? "," : "");
+        }
+        fprintf(file, "  ]\n}\n");
+        fclose(file);
+        return true;
+    }
+
+private:
+    std::string fName;
+    std::vector<Result> fResults;
+};
+
+} // namespace bench
+} // namespace enlil
+
+#endif // ENLIL_BENCH_HPP
@@ -0,0 +1,869 @@
+/*
+ * Bridge Benchmarks - Throughput and latency of the DSP/UI/Godot primitives
+ * Part of the Enlil/GodotVST Framework
+ *
+ * Covers RingBuffer and InputRingBuffer under two-thread contention,
+ * DSPBridge push/drain, FrameBridge submit/swap across frame sizes,
+ * input queue behaviour under bursts, BlobChannel curve handoff to a
+ * simulated audio thread during rapid edits, ParameterSplitter on
+ * frame-stamped automation, Saturator tier switches and split blocks, and
+ * the LookaheadLimiter's ceiling and reported latency. Results are written
+ * as JSON with a threshold per result; the exit code is non-zero if any
+ * threshold is missed (unless --no-check).
+ *
+ * Timing thresholds are a recorded baseline (x86-64, g++ -O2, single core,
+ * the median of three --quick runs) times a margin, so a regression of the
+ * same order fails. A calibration loop at startup scales them to the
+ * machine: a runner that takes longer for it than the recorded one gets
+ * proportionally looser limits. Frame submits are memory-bound and are
+ * measured against a plain memcpy of the same frame, timed alongside.
+ * Deterministic results (losses, delivered edges) have no margin.
+ *
+ * Usage: bench_bridge [--json results.json] [--quick] [--no-check]
+ */
+
+#include "bench.hpp"
+
+#include "../blob_channel.hpp"
+#include "../curve_table.hpp"
+#include "../dsp_bridge.hpp"
+#include "../frame_bridge.hpp"
+#include "../limiter.hpp"
+#include "../param_events.hpp"
+#include "../saturator.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <sys/resource.h>
+
+using enlil::bench::Suite;
+using enlil::bench::nowNs;
+using enlil::bench::percentile;
+using enlil::bench::doNotOptimize;
+using enlil::bench::HIGHER_IS_BETTER;
+
+// Allowed slowdown over the baseline: medians and throughput vary little
+// between runs, tails and maxima follow the scheduler
+static constexpr double kMedianMargin = 4.0;
+static constexpr double kTailMargin = 10.0;
+
+// Best time of calibrate()'s loop on the baseline machine
+static constexpr double kCalibrationBaselineUs = 4350.0;
+
+// This machine's slowdown against the baseline (never below 1)
+static double sMachineScale = 1.0;
+
+// A dependent integer chain, best of several runs: CPU speed without the
+// memory system, cheap enough to run on every start
+static double calibrate() {
+    double bestUs = 1.0e30;
+    for (int run = 0; run < 7; ++run) {
+        const uint64_t start = nowNs();
+        uint32_t x = 1;
+        for (uint32_t i = 0; i < 2000000; ++i) {
+            x = x * 1664525u + 1013904223u;
+            x ^= x >> 13;
+        }
+        doNotOptimize(x);
+        bestUs = std::min(bestUs, (nowNs() - start) / 1000.0);
+    }
+    return bestUs;
+}
+
+// Limits for times and rates from their baseline
+static double medianLimit(double baseline) { return baseline * sMachineScale * kMedianMargin; }
+static double tailLimit(double baseline) { return baseline * sMachineScale * kTailMargin; }
+static double rateLimit(double baseline) { return baseline / (sMachineScale * kMedianMargin); }
+
+// Spin politely: the benchmark must also work on a single core
+static inline void relax() {
+    std::this_thread::yield();
+}
+
+// === Ring buffers ===
+
+// Producer and consumer on separate threads, consumer drains as fast as it can
+template<typename Ring, typename Item>
+static double ringThroughput(Ring& ring, size_t items, const Item& prototype) {
+    std::atomic<bool> go(false);
+
+    std::thread consumer([&] {
+        while (!go.load(std::memory_order_acquire)) {
+            relax();
+        }
+        Item item;
+        size_t received = 0;
+        while (received < items) {
+            if (ring.pop(item)) {
+                received++;
+            } else {
+                relax();
+            }
+        }
+        doNotOptimize(item);
+    });
+
+    const uint64_t start = nowNs();
+    go.store(true, std::memory_order_release);
+    for (size_t i = 0; i < items; ++i) {
+        while (!ring.push(prototype)) {
+            relax();
+        }
+    }
+    consumer.join();
+    const uint64_t elapsed = nowNs() - start;
+
+    return items * 1.0e9 / static_cast<double>(elapsed);
+}
+
+// One item in flight at a time: push → pop handoff latency in ns
+template<typename Ring, typename Item, typename Stamp>
+static std::vector<double> ringLatency(Ring& ring, size_t rounds, Stamp stamp) {
+    std::vector<double> samples;
+    samples.reserve(rounds);
+    std::atomic<size_t> consumed(0);
+
+    std::thread consumer([&] {
+        Item item;
+        for (size_t i = 0; i < rounds; ++i) {
+            while (!ring.pop(item)) {
+                relax();
+            }
+            samples.push_back(static_cast<double>(nowNs() - stamp(item)));
+            consumed.store(i + 1, std::memory_order_release);
+        }
+    });
+
+    for (size_t i = 0; i < rounds; ++i) {
+        Item item = Item();
+        stamp(item) = nowNs();
+        while (!ring.push(item)) {
+            relax();
+        }
+        while (consumed.load(std::memory_order_acquire) <= i) {
+            relax();
+        }
+    }
+    consumer.join();
+    return samples;
+}
+
+struct StampedItem {
+    uint64_t timestamp;
+    float payload[4];
+};
+
+static void benchRingBuffers(Suite& suite, bool quick) {
+    const size_t items = quick ? 200000 : 2000000;
+    const size_t rounds = quick ? 2000 : 20000;
+
+    {
+        static VisualizationRingBuffer ring;
+        const VisualizationData data = {0.1f, 0.2f, 0.3f, 0.4f};
+        suite.add("ring_buffer.throughput", "Mitem/s",
+                  ringThroughput(ring, items, data) / 1.0e6, rateLimit(60.0), HIGHER_IS_BETTER);
+    }
+    {
+        static RingBuffer<StampedItem, 64> ring;
+        std::vector<double> samples = ringLatency<RingBuffer<StampedItem, 64>, StampedItem>(
+            ring, rounds, [](StampedItem& item) -> uint64_t& { return item.timestamp; });
+        suite.add("ring_buffer.latency.p50", "us", percentile(samples, 50) / 1000.0, medianLimit(0.45));
+        suite.add("ring_buffer.latency.p99", "us", percentile(samples, 99) / 1000.0, tailLimit(0.5));
+    }
+    {
+        static enlil::InputEventQueue queue;
+        enlil::InputEvent event = enlil::InputEvent();
+        event.type = enlil::InputEvent::MOUSE_MOTION;
+        suite.add("input_ring_buffer.throughput", "Mitem/s",
+                  ringThroughput(queue, items, event) / 1.0e6, rateLimit(155.0), HIGHER_IS_BETTER);
+    }
+    {
+        static enlil::InputEventQueue queue;
+        std::vector<double> samples = ringLatency<enlil::InputEventQueue, enlil::InputEvent>(
+            queue, rounds, [](enlil::InputEvent& event) -> uint64_t& { return event.timestamp; });
+        suite.add("input_ring_buffer.latency.p50", "us", percentile(samples, 50) / 1000.0, medianLimit(0.45));
+        suite.add("input_ring_buffer.latency.p99", "us", percentile(samples, 99) / 1000.0, tailLimit(0.5));
+    }
+}
+
+// === DSPBridge ===
+
+static void benchDSPBridge(Suite& suite, bool quick) {
+    enlil::DSPBridge& bridge = enlil::DSPBridge::instance();
+    const size_t rounds = quick ? 2000 : 20000;
+
+    // Audio thread side: one push per block, buffer kept from filling
+    std::vector<double> pushSamples;
+    pushSamples.reserve(rounds);
+    for (size_t i = 0; i < rounds; ++i) {
+        const uint64_t start = nowNs();
+        bridge.pushVisualization(0.1f, 0.2f, 0.3f, 0.4f);
+        pushSamples.push_back(static_cast<double>(nowNs() - start));
+        if ((i & 31) == 31) {
+            bridge.pollVisualization();
+        }
+    }
+    bridge.pollVisualization();
+    suite.add("dsp_bridge.push.p99", "ns", percentile(pushSamples, 99), tailLimit(25.0));
+
+    // UI side: drain a full buffer (the UI was stalled for a while)
+    std::vector<double> drainSamples;
+    drainSamples.reserve(rounds);
+    for (size_t i = 0; i < rounds; ++i) {
+        for (int j = 0; j < 64; ++j) {
+            bridge.pushVisualization(0.1f, 0.2f, 0.3f, static_cast<float>(j));
+        }
+        const uint64_t start = nowNs();
+        bridge.pollVisualization();
+        drainSamples.push_back(static_cast<double>(nowNs() - start));
+    }
+    doNotOptimize(bridge.getPeakRight());
+    suite.add("dsp_bridge.drain_full.p50", "ns", percentile(drainSamples, 50), medianLimit(150.0));
+    suite.add("dsp_bridge.drain_full.p99", "ns", percentile(drainSamples, 99), tailLimit(170.0));
+}
+
+// === FrameBridge ===
+
+struct FrameSize {
+    const char* name;
+    int width;
+    int height;
+};
+
+// p50 of a straight RGBA submit over the p50 of a memcpy of the frame
+static constexpr double kSubmitPerCopyBaseline = 1.05;
+
+static void benchFrameBridge(Suite& suite, bool quick) {
+    static const FrameSize sizes[] = {
+        {"600x400", 600, 400},
+        {"1280x720", 1280, 720},
+        {"1920x1080", 1920, 1080},
+        {"3840x2160", 3840, 2160},
+    };
+    const size_t rounds = quick ? 20 : 200;
+
+    uint32_t editorId = 1000;
+    for (const FrameSize& size : sizes) {
+        enlil::FrameBridge& bridge = enlil::FrameBridge::openEditor(editorId);
+
+        std::vector<uint8_t> pixels(static_cast<size_t>(size.width) * size.height * 4, 0x7f);
+        std::vector<uint8_t> copy(pixels.size());
+        std::vector<double> copySamples;
+        std::vector<double> submitSamples;
+        std::vector<double> swapSamples;
+        copySamples.reserve(rounds);
+        submitSamples.reserve(rounds);
+        swapSamples.reserve(rounds);
+        std::memcpy(copy.data(), pixels.data(), pixels.size());
+
+        // First submit allocates the slot, keep it out of the samples
+        bridge.submitFrame(pixels.data(), size.width, size.height);
+        bridge.hasNewFrame();
+        bridge.submitFrame(pixels.data(), size.width, size.height);
+        bridge.hasNewFrame();
+
+        for (size_t i = 0; i < rounds; ++i) {
+            uint64_t start = nowNs();
+            std::memcpy(copy.data(), pixels.data(), pixels.size());
+            doNotOptimize(copy[copy.size() / 2]);
+            copySamples.push_back(static_cast<double>(nowNs() - start));
+
+            start = nowNs();
+            bridge.submitFrame(pixels.data(), size.width, size.height);
+            submitSamples.push_back(static_cast<double>(nowNs() - start));
+
+            start = nowNs();
+            const bool swapped = bridge.hasNewFrame();
+            swapSamples.push_back(static_cast<double>(nowNs() - start));
+            doNotOptimize(swapped);
+            doNotOptimize(bridge.getFrameData());
+        }
+
+        const double megapixels = size.width * size.height / 1.0e6;
+        const double submitP50 = percentile(submitSamples, 50) / 1000.0;
+        const double copyP50 = percentile(copySamples, 50) / 1000.0;
+        const double submitThresholdUs = copyP50 * kSubmitPerCopyBaseline * kMedianMargin;
+        printf("  (%s memcpy p50 %.2f us, submit/memcpy %.2f)\n", size.name, copyP50, submitP50 / copyP50);
+        suite.add(std::string("frame_bridge.submit.") + size.name + ".p50", "us",
+                  submitP50, submitThresholdUs);
+        suite.add(std::string("frame_bridge.submit.") + size.name + ".throughput", "MP/s",
+                  megapixels / (submitP50 / 1.0e6), megapixels / (submitThresholdUs / 1.0e6),
+                  HIGHER_IS_BETTER);
+        suite.add(std::string("frame_bridge.swap.") + size.name + ".p99", "us",
+                  percentile(swapSamples, 99) / 1000.0, tailLimit(0.3));
+
+        enlil::FrameBridge::closeEditor(editorId);
+        editorId++;
+    }
+}
+
+// === Input bursts ===
+
+static void benchInputBurst(Suite& suite, bool quick) {
+    const size_t bursts = quick ? 20 : 200;
+    const size_t burstSize = 2000;
+
+    enlil::FrameBridge& bridge = enlil::FrameBridge::openEditor(2000);
+
+    std::vector<double> pushSamples;
+    pushSamples.reserve(bursts * burstSize);
+    uint64_t edgesPushed = 0;
+    uint64_t edgesReceived = 0;
+
+    for (size_t burst = 0; burst < bursts; ++burst) {
+        // A drag with clicks: mostly motion, an edge every 10 events,
+        // nobody draining while the burst is pushed
+        for (size_t i = 0; i < burstSize; ++i) {
+            const uint64_t start = nowNs();
+            if (i % 10 == 9) {
+                bridge.pushMouseButton(static_cast<float>(i), 0.0f, 1, (i / 10) % 2 == 0);
+                edgesPushed++;
+            } else {
+                bridge.pushMouseMotion(static_cast<float>(i), static_cast<float>(burst));
+            }
+            pushSamples.push_back(static_cast<double>(nowNs() - start));
+        }
+        bridge.flushInputEvents();
+
+        // Godot catches up, a frame at a time
+        enlil::InputEvent events[64];
+        for (int frame = 0; frame < 64; ++frame) {
+            const size_t count = bridge.popInputEvents(events, 64);
+            for (size_t i = 0; i < count; ++i) {
+                if (events[i].type == enlil::InputEvent::MOUSE_BUTTON) {
+                    edgesReceived++;
+                }
+            }
+            bridge.flushInputEvents();
+        }
+    }
+
+    const double coalesced = static_cast<double>(bridge.getCoalescedInputCount());
+    const double total = static_cast<double>(bursts * burstSize);
+
+    // Coalescing and delivery do not depend on timing: 9 of 10 events are
+    // motion, every edge must arrive and nothing is dropped
+    suite.add("input_burst.push.p99", "ns", percentile(pushSamples, 99), tailLimit(100.0));
+    suite.add("input_burst.coalesced_ratio", "ratio", coalesced / total, 0.79, HIGHER_IS_BETTER);
+    suite.add("input_burst.edges_delivered", "ratio",
+              edgesPushed > 0 ? static_cast<double>(edgesReceived) / edgesPushed : 1.0,
+              1.0, HIGHER_IS_BETTER);
+    suite.add("input_burst.dropped", "events",
+              static_cast<double>(bridge.getDroppedInputCount()), 0.0);
+
+    enlil::FrameBridge::closeEditor(2000);
+}
+
+// === Blob channel ===
+
+// Audio side: one acquire per block, then the block reads the table. A
+// stall is an acquire that takes longer than this.
+static constexpr uint64_t kBlobStallNs = 20000;
+
+// Involuntary context switches of the calling thread so far: an acquire
+// the scheduler preempted says nothing about the channel (Linux only)
+static long involuntarySwitches() {
+#ifdef RUSAGE_THREAD
+    struct rusage usage;
+    if (getrusage(RUSAGE_THREAD, &usage) == 0) {
+        return usage.ru_nivcsw;
+    }
+#endif
+    return 0;
+}
+
+// Interrupts and a hypervisor stealing the vCPU leave no context switch
+// behind. They hit an acquire as often as any other window of the same
+// length, so each block also times this many empty windows: what those
+// catch is the machine's own noise, not the channel's.
+static constexpr uint32_t kNoiseProbes = 16;
+
+// Stalls the acquires may have beyond their share of that noise
+static constexpr double kStallAllowance = 2.0;
+
+static void benchBlobChannel(Suite& suite, bool quick) {
+    enlil::BlobChannel channel;
+    const uint64_t durationNs = quick ? 200000000ull : 2000000000ull;
+    const uint32_t blockFrames = 2048;
+
+    std::atomic<bool> done(false);
+    std::vector<double> publishSamples;
+    publishSamples.reserve(1 << 16);
+    uint64_t edits = 0;
+
+    // UI side: a curve drag, rebuilding and publishing the table as fast as
+    // it can. Tables are odd-symmetric: values[0] == -values[kSize - 1].
+    std::thread editor([&] {
+        enlil::CurvePoint points[32];
+        uint32_t seed = 1;
+        while (!done.load(std::memory_order_acquire)) {
+            const uint64_t start = nowNs();
+            for (uint32_t p = 0; p < 32; ++p) {
+                seed = seed * 1664525u + 1013904223u;
+                points[p].x = (p + 1) / 32.0f;
+                points[p].y = static_cast<float>(seed >> 8) / 16777216.0f;
+            }
+            enlil::Blob* blob = channel.allocate(sizeof(enlil::CurveTable));
+            blob->as<enlil::CurveTable>()->build(points, 32);
+            channel.publish(blob);
+            publishSamples.push_back(static_cast<double>(nowNs() - start));
+            edits++;
+            relax();
+        }
+    });
+
+    // Audio side: blocks back to back, yielding in between
+    std::vector<double> acquireSamples;
+    acquireSamples.reserve(1 << 20);
+    uint64_t blocks = 0;
+    uint64_t stalls = 0;
+    uint64_t noiseStalls = 0;
+    uint64_t noiseMaxNs = 0;
+    uint64_t corrupt = 0;
+    float sink = 0.0f;
+
+    const uint64_t end = nowNs() + durationNs;
+    while (nowNs() < end) {
+        const long switches = involuntarySwitches();
+        const uint64_t start = nowNs();
+        const enlil::Blob* blob = channel.acquire();
+        const uint64_t elapsed = nowNs() - start;
+        if (involuntarySwitches() == switches) {
+            acquireSamples.push_back(static_cast<double>(elapsed));
+            if (elapsed > kBlobStallNs) {
+                stalls++;
+            }
+        }
+
+        for (uint32_t probe = 0; probe < kNoiseProbes; ++probe) {
+            const long probeSwitches = involuntarySwitches();
+            const uint64_t probeStart = nowNs();
+            doNotOptimize(probe);
+            const uint64_t probeNs = nowNs() - probeStart;
+            if (involuntarySwitches() == probeSwitches) {
+                noiseMaxNs = std::max(noiseMaxNs, probeNs);
+                if (probeNs > kBlobStallNs) {
+                    noiseStalls++;
+                }
+            }
+        }
+
+        // Shape a block through the table; poisoned (freed) tables read NaN
+        if (blob) {
+            const enlil::CurveTable* table = blob->as<enlil::CurveTable>();
+            const float first = table->values[0];
+            float block = 0.0f;
+            for (uint32_t i = 0; i < blockFrames; ++i) {
+                // Preempted halfway: the editor runs while the table is held
+                if (i == blockFrames / 2) {
+                    relax();
+                }
+                block += table->evaluate(static_cast<float>(i % 256) * (8.0f / 256) - 4.0f);
+            }
+            if (std::isnan(block) || !(first == -table->values[enlil::CurveTable::kSize - 1]) ||
+                !(table->values[0] == first)) {
+                corrupt++;
+            }
+            sink += block;
+        }
+        blocks++;
+        relax();
+    }
+
+    done.store(true, std::memory_order_release);
+    editor.join();
+    doNotOptimize(sink);
+
+    const double seconds = durationNs / 1.0e9;
+    suite.add("blob_channel.acquire.p99", "ns", percentile(acquireSamples, 99), tailLimit(40.0));
+    // A single interruption decides the maximum: it only has to stay below
+    // a stall, or below the worst the empty windows saw. The stalls within
+    // the allowance are noise by the same measure and are set aside.
+    const uint64_t excused = std::min(stalls, static_cast<uint64_t>(kStallAllowance));
+    const double acquireMax = acquireSamples.size() > excused
+        ? percentile(acquireSamples, 100.0 * (acquireSamples.size() - excused) / acquireSamples.size())
+        : 0.0;
+    printf("  (noise windows: %llu stalls, max %.2f us)\n",
+           static_cast<unsigned long long>(noiseStalls), noiseMaxNs / 1000.0);
+    suite.add("blob_channel.acquire.max", "us", acquireMax / 1000.0,
+              std::max(kBlobStallNs, noiseMaxNs) / 1000.0);
+    suite.add("blob_channel.audio_stalls", "blocks", static_cast<double>(stalls),
+              static_cast<double>(noiseStalls) / kNoiseProbes + kStallAllowance);
+    suite.add("blob_channel.corrupt_reads", "blocks", static_cast<double>(corrupt), 0.0);
+    suite.add("blob_channel.edits", "1/s", edits / seconds, rateLimit(48000.0), HIGHER_IS_BETTER);
+    suite.add("blob_channel.publish.p99", "us", percentile(publishSamples, 99) / 1000.0, tailLimit(23.0));
+    suite.add("blob_channel.retired_max", "blobs", static_cast<double>(channel.getRetiredMax()), 4.0 * kMedianMargin);
+    doNotOptimize(blocks);
+}
+
+// === Parameter events ===
+
+// Sub-block end values against the exact piecewise-linear automation:
+// float interpolation rounds, nothing more
+static constexpr double kSplitterRoundingPpm = 1.0;
+
+static void benchParameterSplitter(Suite& suite, bool quick) {
+    static constexpr size_t kCapacity = 64;
+    static constexpr uint32_t kParameters = 2;
+    using Queue = enlil::ParameterEventQueue<kCapacity>;
+
+    const uint32_t blocks = quick ? 2000 : 20000;
+    uint32_t seed = 3;
+    auto random = [&seed](uint32_t range) {
+        seed = seed * 1664525u + 1013904223u;
+        return (seed >> 8) % range;
+    };
+
+    Queue events;
+    float values[kParameters] = { 0.0f, 1.0f };
+    uint64_t gaps = 0;
+    uint64_t missedPoints = 0;
+    double maxDeviation = 0.0;
+    uint64_t subBlocks = 0;
+
+    for (uint32_t block = 0; block < blocks; ++block) {
+        // Some empty blocks, points at 0, past the end and at kEndOfBlock,
+        // several at one frame
+        const uint32_t frames = random(8) == 0 ? 0 : 1 + random(1024);
+        events.clear();
+        const uint32_t points = random(12);
+        for (uint32_t i = 0; i < points; ++i) {
+            const uint32_t kind = random(8);
+            const uint32_t frame = kind == 0 ? 0 : kind == 1 ? Queue::kEndOfBlock
+                                 : kind == 2 ? frames + random(64) : random(frames + 1);
+            events.push(frame, random(kParameters), static_cast<float>(random(1000001)) / 1.0e6f);
+        }
+
+        // Knots of the exact automation: the block start, then every point
+        // (the last one at a frame wins); clamped to the block
+        std::vector<std::pair<uint32_t, double>> knots[kParameters];
+        for (uint32_t p = 0; p < kParameters; ++p) {
+            knots[p].push_back({0, values[p]});
+        }
+        for (size_t i = 0; i < events.size(); ++i) {
+            std::vector<std::pair<uint32_t, double>>& list = knots[events[i].index];
+            const uint32_t frame = std::min(events[i].frame, frames);
+            if (list.back().first == frame) {
+                list.back().second = events[i].value;
+            } else {
+                list.push_back({frame, events[i].value});
+            }
+        }
+        auto exact = [&knots](uint32_t p, uint32_t frame) {
+            const std::vector<std::pair<uint32_t, double>>& list = knots[p];
+            for (size_t k = 1; k < list.size(); ++k) {
+                if (frame <= list[k].first) {
+                    const double t = static_cast<double>(frame - list[k - 1].first) /
+                                     (list[k].first - list[k - 1].first);
+                    return list[k - 1].second + (list[k].second - list[k - 1].second) * t;
+                }
+            }
+            return list.back().second;
+        };
+
+        enlil::ParameterSplitter<kCapacity, kParameters> splitter(events, frames, values);
+        uint32_t expectedStart = 0;
+        uint32_t start, end;
+        while (splitter.next(start, end)) {
+            subBlocks++;
+            if (start != expectedStart || end <= start || end > frames) {
+                gaps++;
+            }
+            expectedStart = end;
+
+            for (uint32_t p = 0; p < kParameters; ++p) {
+                const std::vector<std::pair<uint32_t, double>>& list = knots[p];
+                const bool atPoint = std::find_if(list.begin() + 1, list.end(),
+                    [end](const std::pair<uint32_t, double>& knot) { return knot.first == end; }) != list.end();
+                const double value = splitter.getValue(p);
+                if (atPoint && value != static_cast<float>(exact(p, end))) {
+                    missedPoints++;
+                }
+                maxDeviation = std::max(maxDeviation, std::fabs(value - exact(p, end)));
+            }
+        }
+        if (expectedStart != frames) {
+            gaps++;
+        }
+
+        // The block ends exactly on each parameter's last point
+        for (uint32_t p = 0; p < kParameters; ++p) {
+            if (splitter.getValue(p) != static_cast<float>(knots[p].back().second)) {
+                missedPoints++;
+            }
+            values[p] = splitter.getValue(p);
+        }
+    }
+
+    doNotOptimize(subBlocks);
+    suite.add("param_events.gaps", "blocks", static_cast<double>(gaps), 0.0);
+    suite.add("param_events.missed_points", "points", static_cast<double>(missedPoints), 0.0);
+    suite.add("param_events.max_deviation", "ppm", maxDeviation * 1.0e6, kSplitterRoundingPpm);
+}
+
+// === Saturator ===
+
+// A tier switch may not step harder than the signal does anywhere else
+static constexpr double kSwitchStepMargin = 1.1;
+
+// Splitting a ramp changes where it is rounded, not where it goes
+static constexpr double kSplitRoundingPpm = 50.0;
+
+static void benchSaturator(Suite& suite, bool quick) {
+    const uint32_t blockFrames = 256;
+    const uint32_t frames = blockFrames * (quick ? 64 : 512);
+    const double pi = 3.14159265358979323846;
+
+    std::vector<float> input(frames);
+    std::vector<float> whole(frames);
+    std::vector<float> split(frames);
+    // Slow enough that the signal's own steps are smaller than the
+    // difference between tiers: a hard switch would stand out
+    for (uint32_t i = 0; i < frames; ++i) {
+        input[i] = static_cast<float>(0.5 * std::sin(2.0 * pi * 60.0 * i / 48000.0));
+    }
+
+    // Large state: keep it off the stack
+    std::unique_ptr<enlil::Saturator> saturator(new enlil::Saturator());
+    std::unique_ptr<enlil::Saturator> other(new enlil::Saturator());
+
+    // Every tier pair: the largest sample-to-sample step during the
+    // crossfade against the largest one outside it
+    double switchRatio = 0.0;
+    const uint32_t switchFrame = (frames / 2 / blockFrames) * blockFrames;
+    for (uint32_t from = 0; from < enlil::DSP_TIER_COUNT; ++from) {
+        for (uint32_t to = 0; to < enlil::DSP_TIER_COUNT; ++to) {
+            if (from == to) {
+                continue;
+            }
+            saturator->reset(2.0f, 1.0f);
+            saturator->setTier(static_cast<enlil::DSPTier>(from));
+            for (uint32_t start = 0; start < frames; start += blockFrames) {
+                if (start == switchFrame) {
+                    saturator->setTier(static_cast<enlil::DSPTier>(to));
+                }
+                saturator->process(&input[start], &whole[start], blockFrames, 2.0f, 1.0f);
+            }
+
+            // Skip the first blocks: the start-up switch fades from Normal
+            double steady = 0.0;
+            double atSwitch = 0.0;
+            for (uint32_t i = 4 * blockFrames; i < frames; ++i) {
+                const double step = std::fabs(whole[i] - whole[i - 1]);
+                if (i >= switchFrame && i <= switchFrame + enlil::Saturator::kCrossfadeFrames) {
+                    atSwitch = std::max(atSwitch, step);
+                } else {
+                    steady = std::max(steady, step);
+                }
+            }
+            switchRatio = std::max(switchRatio, atSwitch / steady);
+        }
+    }
+
+    // The same blocks processed whole and split at random points, with
+    // drive and gain ramps cut where the whole ramp passes: held values
+    // give identical output in every tier, ramps (Normal, HQ) the same
+    // trajectory up to rounding
+    double heldError = 0.0;
+    double rampedError = 0.0;
+    for (int ramped = 0; ramped < 2; ++ramped) {
+        for (uint32_t tier = 0; tier < enlil::DSP_TIER_COUNT; ++tier) {
+            if (ramped && tier == enlil::DSP_TIER_ECO) {
+                continue; // holds the end values per call by design
+            }
+            saturator->reset(4.0f, 0.5f);
+            other->reset(4.0f, 0.5f);
+            saturator->setTier(static_cast<enlil::DSPTier>(tier));
+            other->setTier(static_cast<enlil::DSPTier>(tier));
+
+            const uint32_t chunk = 1000;
+            uint32_t seed = 7;
+            float drive = 4.0f;
+            float gain = 0.5f;
+            for (uint32_t start = 0; start < frames; start += chunk) {
+                const uint32_t count = std::min(chunk, frames - start);
+                const uint32_t step = start / chunk;
+                const float nextDrive = ramped ? 1.0f + (step % 5) * 2.0f : drive;
+                const float nextGain = ramped ? 1.0f / (1 + step % 3) : gain;
+                saturator->process(&input[start], &whole[start], count, nextDrive, nextGain);
+
+                for (uint32_t offset = 0; offset < count;) {
+                    seed = seed * 1664525u + 1013904223u;
+                    const uint32_t length = std::min(count - offset, 1 + (seed >> 8) % 300);
+                    const float t = static_cast<float>(offset + length) / count;
+                    other->process(&input[start + offset], &split[start + offset], length,
+                                   drive + (nextDrive - drive) * t, gain + (nextGain - gain) * t);
+                    offset += length;
+                }
+                drive = nextDrive;
+                gain = nextGain;
+            }
+
+            double& error = ramped ? rampedError : heldError;
+            for (uint32_t i = 0; i < frames; ++i) {
+                error = std::max(error, static_cast<double>(std::fabs(whole[i] - split[i])));
+            }
+        }
+    }
+
+    suite.add("saturator.switch_step_ratio", "x", switchRatio, kSwitchStepMargin);
+    suite.add("saturator.split_error.held", "FS", heldError, 0.0);
+    suite.add("saturator.split_error.ramped", "ppm", rampedError * 1.0e6, kSplitRoundingPpm);
+}
+
+// === Lookahead limiter ===
+
+// Hot stereo test signals, up to +12 dB over full scale
+static void limiterSignal(uint32_t kind, uint32_t frame, uint32_t& seed, float& left, float& right) {
+    const double pi = 3.14159265358979323846;
+    switch (kind) {
+    case 0: // fs/4 sine sampled 45 degrees off its peaks: inter-sample peaks
+        left = static_cast<float>(4.0 * std::sin(pi * 0.5 * frame + pi * 0.25));
+        right = -left;
+        break;
+    case 1: // Noise
+        seed = seed * 1664525u + 1013904223u;
+        left = static_cast<float>(seed >> 8) / 2097152.0f - 4.0f;
+        seed = seed * 1664525u + 1013904223u;
+        right = static_cast<float>(seed >> 8) / 2097152.0f - 4.0f;
+        break;
+    default: // Bursts: isolated clicks and square steps after silence
+        left = frame % 997 == 0 ? 4.0f : 0.0f;
+        right = (frame / 331) % 3 == 0 ? 3.0f : 0.1f;
+        break;
+    }
+}
+
+static void benchLimiter(Suite& suite, bool quick) {
+    static const double kSampleRates[] = { 44100.0, 48000.0, 96000.0 };
+    const uint32_t blockFrames = 256;
+    const uint32_t frames = quick ? 48000 : 480000;
+    const float ceiling = 0.989f;
+
+    // Large state: keep it off the stack
+    std::unique_ptr<enlil::LookaheadLimiter> limiter(new enlil::LookaheadLimiter());
+    limiter->setCeiling(ceiling);
+
+    float left[blockFrames];
+    float right[blockFrames];
+    float* io[2] = { left, right };
+
+    // Output never exceeds the ceiling, whatever the signal and detection
+    float maxOutput = 0.0f;
+    for (double sampleRate : kSampleRates) {
+        for (int truePeak = 0; truePeak < 2; ++truePeak) {
+            for (uint32_t kind = 0; kind < 3; ++kind) {
+                limiter->setSampleRate(sampleRate);
+                limiter->setTruePeak(truePeak != 0);
+                uint32_t seed = 1;
+                for (uint32_t start = 0; start < frames; start += blockFrames) {
+                    for (uint32_t i = 0; i < blockFrames; ++i) {
+                        limiterSignal(kind, start + i, seed, left[i], right[i]);
+                    }
+                    limiter->process(io, 2, blockFrames);
+                    for (uint32_t i = 0; i < blockFrames; ++i) {
+                        maxOutput = std::max(maxOutput, std::max(std::fabs(left[i]), std::fabs(right[i])));
+                    }
+                }
+            }
+        }
+    }
+
+    // An impulse comes out getLatency() samples later, limited or not
+    uint32_t latencyError = 0;
+    for (double sampleRate : kSampleRates) {
+        for (int truePeak = 0; truePeak < 2; ++truePeak) {
+            for (float amplitude : { 0.5f, 4.0f }) {
+                limiter->setSampleRate(sampleRate);
+                limiter->setTruePeak(truePeak != 0);
+                const uint32_t offset = 17; // not on a block boundary
+                uint32_t peakFrame = 0;
+                float peak = 0.0f;
+                for (uint32_t start = 0; start < 4 * blockFrames + enlil::LookaheadLimiter::kMaxLookahead;
+                     start += blockFrames) {
+                    for (uint32_t i = 0; i < blockFrames; ++i) {
+                        left[i] = start + i == offset ? amplitude : 0.0f;
+                        right[i] = 0.0f;
+                    }
+                    limiter->process(io, 2, blockFrames);
+                    for (uint32_t i = 0; i < blockFrames; ++i) {
+                        if (std::fabs(left[i]) > peak) {
+                            peak = std::fabs(left[i]);
+                            peakFrame = start + i;
+                        }
+                    }
+                }
+                const uint32_t delay = peakFrame - offset;
+                const uint32_t latency = limiter->getLatency();
+                latencyError = std::max(latencyError, delay > latency ? delay - latency : latency - delay);
+            }
+        }
+    }
+
+    // Rounding of sample * (ceiling / peak) may land an ulp (0.06 ppm) above
+    const double overshoot = std::max(0.0, (static_cast<double>(maxOutput) / ceiling - 1.0) * 1.0e6);
+    suite.add("limiter.ceiling_overshoot", "ppm", overshoot, 1.0);
+    suite.add("limiter.latency_error", "samples", static_cast<double>(latencyError), 0.0);
+}
+
+int main(int argc, char** argv)
+{
+    const char* jsonPath = nullptr;
+    bool quick = false;
+    bool check = true;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--quick") == 0) {
+            quick = true;
+        } else if (std::strcmp(argv[i], "--no-check") == 0) {
+            check = false;
+        } else {
+            fprintf(stderr, "Usage: %s [--json results.json] [--quick] [--no-check]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    Suite suite("bridge");
+
+    const double calibrationUs = calibrate();
+    sMachineScale = std::max(1.0, calibrationUs / kCalibrationBaselineUs);
+    printf("[Bench] Calibration loop %.0f us (baseline %.0f us), limits scaled %.2fx\n",
+           calibrationUs, kCalibrationBaselineUs, sMachineScale);
+
+    printf("[Bench] Ring buffers\n");
+    benchRingBuffers(suite, quick);
+    printf("[Bench] DSPBridge\n");
+    benchDSPBridge(suite, quick);
+    printf("[Bench] FrameBridge\n");
+    benchFrameBridge(suite, quick);
+    printf("[Bench] Input bursts\n");
+    benchInputBurst(suite, quick);
+    printf("[Bench] Blob channel\n");
+    benchBlobChannel(suite, quick);
+    printf("[Bench] Parameter events\n");
+    benchParameterSplitter(suite, quick);
+    printf("[Bench] Saturator\n");
+    benchSaturator(suite, quick);
+    printf("[Bench] Lookahead limiter\n");
+    benchLimiter(suite, quick);
+
+    if (jsonPath && !suite.writeJson(jsonPath)) {
+        return 2;
+    }
+
+    if (!suite.passed()) {
+        fprintf(stderr, "[Bench] %zu result(s) missed their threshold\n", suite.failureCount());
+        return check ? 1 : 0;
+    }
+
+    printf("[Bench] All results within thresholds\n");
+    return 0;
+}
@@ -0,0 +1,206 @@
+/*
+ * Blob Channel - Lock-free handoff of immutable data blocks to the audio thread
+ * Part of the Enlil/GodotVST Framework
+ *
+ * Moves arbitrary-size tables (curves, LUTs) from non-real-time threads to
+ * one real-time reader without locks or allocation on the reader's side:
+ * - the writer allocates a Blob, fills it, and publishes it by swapping
+ *   the current pointer, then bumps the epoch; the blob it replaced is
+ *   retired at that epoch
+ * - the reader calls acquire() at block start: it acknowledges the epoch
+ *   and picks up the current blob, and gives up the one it held before
+ * - the writer frees retired blobs whose epoch the reader has acknowledged
+ *   (publish() does, reclaim() can be called any time)
+ *
+ * The reader only ever does three atomic operations per block. A reader
+ * that stops processing calls release() so reclamation does not wait on it.
+ * Typed payloads (create<T>()) are destroyed by the writer that frees
+ * them, so a blob may hold references to shared tables (DSPTableCache).
+ *
+ * Writers: any non-real-time thread (serialized internally).
+ * Reader: one thread at a time, e.g. the plugin's run().
+ */
+
+#ifndef BLOB_CHANNEL_HPP
+#define BLOB_CHANNEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace enlil {
+
+// Header of a published block; the payload follows it, 16-byte aligned.
+// Immutable once published.
+struct alignas(16) Blob {
+    size_t size;
+
+    // Destructor of a typed payload, nullptr for raw bytes
+    void (*destroyPayload)(void* payload);
+
+    void* data() { return this + 1; }
+    const void* data() const { return this + 1; }
+
+    template<typename T>
+    T* as() { return static_cast<T*>(data()); }
+
+    template<typename T>
+    const T* as() const { return static_cast<const T*>(data()); }
+};
+
+class BlobChannel {
+public:
+    BlobChannel()
+        : fCurrent(nullptr),
+          fEpoch(1),
+          fReaderEpoch(kReaderIdle),
+          fRetiredMax(0)
+    {}
+
+    ~BlobChannel() {
+        destroy(fCurrent.load(std::memory_order_acquire));
+        for (const Retired& retired : fRetired) {
+            destroy(retired.blob);
+        }
+    }
+
+    // === Writer (non-real-time) ===
+
+    // Uninitialized payload of the given size; nullptr if out of memory.
+    // Hand it to publish() or discard().
+    Blob* allocate(size_t bytes) {
+        void* memory = ::operator new(sizeof(Blob) + bytes, std::nothrow);
+        if (!memory) {
+            return nullptr;
+        }
+        Blob* blob = new (memory) Blob;
+        blob->size = bytes;
+        blob->destroyPayload = nullptr;
+        return blob;
+    }
+
+    // Payload constructed as T(args...) and destroyed with the blob;
+    // nullptr if out of memory
+    template<typename T, typename... Args>
+    Blob* create(Args&&... args) {
+        static_assert(alignof(T) <= alignof(Blob), "Blob payloads are 16-byte aligned");
+        Blob* blob = allocate(sizeof(T));
+        if (!blob) {
+            return nullptr;
+        }
+        new (blob->data()) T(std::forward<Args>(args)...);
+        blob->destroyPayload = [](void* payload) { static_cast<T*>(payload)->~T(); };
+        return blob;
+    }
+
+    void discard(Blob* blob) {
+        destroy(blob);
+    }
+
+    // Make blob (or nullptr: nothing) what the reader picks up next, and
+    // free what it can. Takes ownership.
+    void publish(Blob* blob) {
+        std::lock_guard<std::mutex> lock(fWriterMutex);
+
+        // The pointer changes before the epoch does: a reader that has seen
+        // the new epoch can only load the new blob (or a later one)
+        Blob* previous = fCurrent.exchange(blob, std::memory_order_seq_cst);
+        const uint64_t epoch = fEpoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+        if (previous) {
+            fRetired.push_back({previous, epoch});
+            fRetiredMax = std::max(fRetiredMax, fRetired.size());
+        }
+        reclaimLocked();
+    }
+
+    // Free retired blobs the reader can no longer hold; returns how many
+    // are still waiting for it
+    size_t reclaim() {
+        std::lock_guard<std::mutex> lock(fWriterMutex);
+        return reclaimLocked();
+    }
+
+    // Most blobs waiting for the reader at once (writer side statistics)
+    size_t getRetiredMax() {
+        std::lock_guard<std::mutex> lock(fWriterMutex);
+        return fRetiredMax;
+    }
+
+    // === Reader (real-time, one thread at a time) ===
+
+    // Call at block start. Returns the newest blob (nullptr if none), valid
+    // until the next acquire() or release(); the blob returned by the
+    // previous call must not be used after this one.
+    const Blob* acquire() {
+        // Acknowledge before loading: whatever is retired at or before this
+        // epoch was swapped out before the load below
+        const uint64_t epoch = fEpoch.load(std::memory_order_seq_cst);
+        fReaderEpoch.store(epoch, std::memory_order_seq_cst);
+        return fCurrent.load(std::memory_order_seq_cst);
+    }
+
+    // The reader holds nothing until its next acquire() (deactivated)
+    void release() {
+        fReaderEpoch.store(kReaderIdle, std::memory_order_seq_cst);
+    }
+
+private:
+    static constexpr uint64_t kReaderIdle = UINT64_MAX;
+
+    struct Retired {
+        Blob* blob;
+        uint64_t epoch;
+    };
+
+    size_t reclaimLocked() {
+        const uint64_t readerEpoch = fReaderEpoch.load(std::memory_order_seq_cst);
+        size_t kept = 0;
+        for (const Retired& retired : fRetired) {
+            if (readerEpoch >= retired.epoch) {
+                destroy(retired.blob);
+            } else {
+                fRetired[kept++] = retired;
+            }
+        }
+        fRetired.resize(kept);
+        return kept;
+    }
+
+    static void destroy(Blob* blob) {
+        if (!blob) {
+            return;
+        }
+        if (blob->destroyPayload) {
+            blob->destroyPayload(blob->data());
+        }
+#ifdef ENLIL_BLOB_POISON
+        // Make use after free visible to tests
+        std::memset(blob->data(), 0xFF, blob->size);
+#endif
+        blob->~Blob();
+        ::operator delete(blob);
+    }
+
+    // Shared with the reader
+    std::atomic<Blob*> fCurrent;
+    std::atomic<uint64_t> fEpoch;
+    std::atomic<uint64_t> fReaderEpoch;
+
+    // Writer side
+    std::mutex fWriterMutex;
+    std::vector<Retired> fRetired;
+    size_t fRetiredMax;
+
+    BlobChannel(const BlobChannel&) = delete;
+    BlobChannel& operator=(const BlobChannel&) = delete;
+};
+
+} // namespace enlil
+
+#endif // BLOB_CHANNEL_HPP
@@ -0,0 +1,176 @@
+/*
+ * Curve Table - A drawn saturation curve as a lookup table
+ * Part of the Enlil/GodotVST Framework
+ *
+ * The UI describes a transfer curve as control points (x, y) for the
+ * positive half: x from 0 to 1 covers the driven input 0..kRange, y is the
+ * output. The curve is odd-symmetric, passes through (0, 0) and holds its
+ * last value beyond the last point and beyond kRange, like tanh does.
+ *
+ * build() samples it into kSize knots with linear interpolation, plus the
+ * exact antiderivative at each knot so the Normal tier can keep its
+ * antiderivative anti-aliasing. The struct is flat and fixed-size: it is
+ * built in place in a BlobChannel payload off the audio thread.
+ *
+ * Text form (state value): "x y x y ...", x strictly increasing.
+ */
+
+#ifndef CURVE_TABLE_HPP
+#define CURVE_TABLE_HPP
+
+#include <cmath>
+#include <cstdint>
+
+namespace enlil {
+
+struct CurvePoint {
+    float x;
+    float y;
+};
+
+struct CurveTable {
+    static constexpr uint32_t kSize = 1025;
+    static constexpr float kRange = 4.0f;
+    static constexpr uint32_t kMaxPoints = 256;
+
+    // Knot spacing in driven input, and knots per unit of input
+    static constexpr double kStep = 2.0 * kRange / (kSize - 1);
+    static constexpr float kScale = static_cast<float>((kSize - 1) / (2.0 * kRange));
+
+    // Curve at knot k (input -kRange + k * kStep), and its integral from
+    // -kRange to there
+    float values[kSize];
+    double integrals[kSize];
+
+    float evaluate(float x) const {
+        const float position = (x + kRange) * kScale;
+        if (!(position > 0.0f)) {
+            return values[0];
+        }
+        if (position >= static_cast<float>(kSize - 1)) {
+            return values[kSize - 1];
+        }
+        const uint32_t k = static_cast<uint32_t>(position);
+        const float t = position - static_cast<float>(k);
+        return values[k] + (values[k + 1] - values[k]) * t;
+    }
+
+    double evaluate(double x) const {
+        return evaluate(static_cast<float>(x));
+    }
+
+    // Exact integral of the interpolated curve
+    double antiderivative(double x) const {
+        const double position = (x + kRange) / kStep;
+        if (!(position > 0.0)) {
+            return values[0] * (x + kRange);
+        }
+        if (position >= kSize - 1) {
+            return integrals[kSize - 1] + values[kSize - 1] * (x - kRange);
+        }
+        const uint32_t k = static_cast<uint32_t>(position);
+        const double t = position - k;
+        return integrals[k] + kStep * t * (values[k] + 0.5 * t * (values[k + 1] - values[k]));
+    }
+
+    // Sample control points (x strictly increasing in [0, 1], y clamped
+    // to [-1, 1]) into the table
+    void build(const CurvePoint* points, uint32_t count) {
+        for (uint32_t k = 0; k < kSize; ++k) {
+            const double input = -kRange + k * kStep;
+            const double x = std::fabs(input) / kRange;
+
+            // Segment from the previous point (or the origin) to the next
+            double x0 = 0.0, y0 = 0.0;
+            double y = count > 0 ? clampOutput(points[count - 1].y) : 0.0;
+            for (uint32_t p = 0; p < count; ++p) {
+                const double x1 = points[p].x;
+                const double y1 = clampOutput(points[p].y);
+                if (x <= x1) {
+                    y = x1 > x0 ? y0 + (y1 - y0) * (x - x0) / (x1 - x0) : y1;
+                    break;
+                }
+                x0 = x1;
+                y0 = y1;
+            }
+            values[k] = static_cast<float>(input < 0.0 ? -y : y);
+        }
+
+        integrals[0] = 0.0;
+        for (uint32_t k = 1; k < kSize; ++k) {
+            integrals[k] = integrals[k - 1] + 0.5 * kStep * (static_cast<double>(values[k - 1]) + values[k]);
+        }
+    }
+
+    // Parse the text form; false if it is malformed, empty or too long
+    static bool parse(const char* text, CurvePoint* points, uint32_t& count) {
+        count = 0;
+        const char* cursor = text;
+
+        for (;;) {
+            float x, y;
+            if (!parseNumber(cursor, x)) {
+                break;
+            }
+            if (!parseNumber(cursor, y) || count == kMaxPoints ||
+                x < 0.0f || x > 1.0f || (count > 0 && x <= points[count - 1].x)) {
+                return false;
+            }
+            points[count].x = x;
+            points[count].y = y;
+            ++count;
+        }
+
+        skipSpace(cursor);
+        return *cursor == '\0' && count > 0;
+    }
+
+private:
+    static void skipSpace(const char*& cursor) {
+        while (*cursor == ' ' || *cursor == '\t' || *cursor == '\n' || *cursor == '\r') {
+            ++cursor;
+        }
+    }
+
+    // Plain decimal ("-0.25"), independent of the host's locale, unlike
+    // strtof
+    static bool parseNumber(const char*& cursor, float& value) {
+        const char* c = cursor;
+        skipSpace(c);
+
+        const bool negative = *c == '-';
+        if (*c == '-' || *c == '+') {
+            ++c;
+        }
+
+        double number = 0.0;
+        bool digits = false;
+        for (; *c >= '0' && *c <= '9'; ++c) {
+            number = number * 10.0 + (*c - '0');
+            digits = true;
+        }
+        if (*c == '.') {
+            double scale = 0.1;
+            for (++c; *c >= '0' && *c <= '9'; ++c) {
+                number += (*c - '0') * scale;
+                scale *= 0.1;
+                digits = true;
+            }
+        }
+        if (!digits) {
+            return false;
+        }
+
+        value = static_cast<float>(negative ? -number : number);
+        cursor = c;
+        return true;
+    }
+
+    static double clampOutput(float y) {
+        return y < -1.0f ? -1.0 : (y > 1.0f ? 1.0 : y);
+    }
+};
+
+} // namespace enlil
+
+#endif // CURVE_TABLE_HPP
@@ -0,0 +1,217 @@
+/*
+ * DSP Load Meter - Audio-thread load and deadline-miss detection
+ * Part of the Enlil/GodotVST Framework
+ *
+ * Measures the wall time of each process block with the CPU cycle counter
+ * (rdtsc on x86-64, cntvct_el0 on AArch64, steady clock elsewhere) and
+ * compares it with the block's real-time budget, frames / sample rate.
+ *
+ * The audio thread accumulates blocks over a short window of audio time and
+ * then publishes min/avg/max load to atomics, so readers (UI thread, host
+ * parameter polling) never block it. Blocks that take longer than their
+ * budget are deadline overruns: the host would have produced an xrun if it
+ * had no slack. Blocks over kNearMissLoad are counted separately.
+ */
+
+#ifndef DSP_LOAD_HPP
+#define DSP_LOAD_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#define ENLIL_DSP_LOAD_RDTSC 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#elif defined(__aarch64__)
+#define ENLIL_DSP_LOAD_CNTVCT 1
+#endif
+
+namespace enlil {
+
+class DSPLoadMeter {
+public:
+    // Load (0..1 of the budget) above which a block counts as a near miss
+    static constexpr double kNearMissLoad = 0.8;
+
+    // Audio time accumulated before min/avg/max are published
+    static constexpr double kWindowSeconds = 0.25;
+
+    DSPLoadMeter()
+        : fTicksPerSecond(ticksPerSecond()),
+          fSampleRate(48000.0),
+          fWindowFrames(0),
+          fWindowFrameLimit(static_cast<uint64_t>(48000.0 * kWindowSeconds)),
+          fWindowBusyTicks(0),
+          fWindowBudgetTicks(0.0),
+          fWindowMin(0.0),
+          fWindowMax(0.0),
+          fBlockLoad(0.0),
+          fLoad(0.0f),
+          fMinLoad(0.0f),
+          fMaxLoad(0.0f),
+          fOverruns(0),
+          fNearMisses(0)
+    {}
+
+    // Call when the sample rate changes (not while run() is executing)
+    void setSampleRate(double sampleRate) {
+        if (sampleRate <= 0.0) {
+            return;
+        }
+        fSampleRate = sampleRate;
+        fWindowFrameLimit = static_cast<uint64_t>(sampleRate * kWindowSeconds);
+        resetWindow();
+    }
+
+    // === Audio thread ===
+
+    // Read the counter at the start of a block
+    static uint64_t begin() {
+        return readTicks();
+    }
+
+    // Account a block started with begin()
+    void end(uint64_t startTicks, uint32_t frames) {
+        const uint64_t busyTicks = readTicks() - startTicks;
+        if (frames == 0) {
+            return;
+        }
+
+        const double budgetTicks = frames / fSampleRate * fTicksPerSecond;
+        const double load = busyTicks / budgetTicks;
+        fBlockLoad = load;
+
+        if (load > 1.0) {
+            fOverruns.fetch_add(1, std::memory_order_relaxed);
+            processOverruns().fetch_add(1, std::memory_order_relaxed);
+        } else if (load > kNearMissLoad) {
+            fNearMisses.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        if (fWindowFrames == 0) {
+            fWindowMin = load;
+            fWindowMax = load;
+        } else {
+            if (load < fWindowMin) fWindowMin = load;
+            if (load > fWindowMax) fWindowMax = load;
+        }
+        fWindowBusyTicks += busyTicks;
+        fWindowBudgetTicks += budgetTicks;
+        fWindowFrames += frames;
+
+        if (fWindowFrames >= fWindowFrameLimit) {
+            // Average is time-weighted: busy time over budget of the window
+            fLoad.store(static_cast<float>(fWindowBusyTicks / fWindowBudgetTicks * 100.0),
+                        std::memory_order_relaxed);
+            fMinLoad.store(static_cast<float>(fWindowMin * 100.0), std::memory_order_relaxed);
+            fMaxLoad.store(static_cast<float>(fWindowMax * 100.0), std::memory_order_relaxed);
+            resetWindow();
+        }
+    }
+
+    // Load of the last block (0..1 of its budget, above 1 on an overrun)
+    double getBlockLoad() const { return fBlockLoad; }
+
+    // === Any thread ===
+
+    // Load of the last window in percent of the real-time budget
+    float getLoad() const { return fLoad.load(std::memory_order_relaxed); }
+    float getMinLoad() const { return fMinLoad.load(std::memory_order_relaxed); }
+    float getMaxLoad() const { return fMaxLoad.load(std::memory_order_relaxed); }
+
+    // Blocks that exceeded their budget / came within kNearMissLoad of it
+    uint64_t getOverrunCount() const { return fOverruns.load(std::memory_order_relaxed); }
+    uint64_t getNearMissCount() const { return fNearMisses.load(std::memory_order_relaxed); }
+
+    // Overruns of every meter in the process, so an editor also notices
+    // other instances missing their deadline on the shared cores
+    static uint64_t getProcessOverrunCount() {
+        return processOverruns().load(std::memory_order_relaxed);
+    }
+
+    // Counter ticks per second, calibrated once per process against the
+    // steady clock (about 2 ms of busy-waiting on first use)
+    static double ticksPerSecond() {
+        static const double calibrated = calibrate();
+        return calibrated;
+    }
+
+private:
+    static uint64_t readTicks() {
+#if defined(ENLIL_DSP_LOAD_RDTSC)
+        return __rdtsc();
+#elif defined(ENLIL_DSP_LOAD_CNTVCT)
+        uint64_t ticks;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+        return ticks;
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    static double calibrate() {
+#if defined(ENLIL_DSP_LOAD_CNTVCT)
+        uint64_t frequency;
+        asm volatile("mrs %0, cntfrq_el0" : "=r"(frequency));
+        return static_cast<double>(frequency);
+#elif defined(ENLIL_DSP_LOAD_RDTSC)
+        using Clock = std::chrono::steady_clock;
+        const Clock::time_point clockStart = Clock::now();
+        const uint64_t ticksStart = readTicks();
+
+        Clock::time_point clockEnd;
+        do {
+            clockEnd = Clock::now();
+        } while (clockEnd - clockStart < std::chrono::milliseconds(2));
+        const uint64_t ticksEnd = readTicks();
+
+        const double seconds = std::chrono::duration<double>(clockEnd - clockStart).count();
+        return (ticksEnd - ticksStart) / seconds;
+#else
+        return 1.0e9;
+#endif
+    }
+
+    static std::atomic<uint64_t>& processOverruns() {
+        static std::atomic<uint64_t> overruns{0};
+        return overruns;
+    }
+
+    void resetWindow() {
+        fWindowFrames = 0;
+        fWindowBusyTicks = 0;
+        fWindowBudgetTicks = 0.0;
+    }
+
+    const double fTicksPerSecond;
+    double fSampleRate;
+
+    // Current window (audio thread only)
+    uint64_t fWindowFrames;
+    uint64_t fWindowFrameLimit;
+    uint64_t fWindowBusyTicks;
+    double fWindowBudgetTicks;
+    double fWindowMin;
+    double fWindowMax;
+    double fBlockLoad;
+
+    // Published (written by the audio thread, read anywhere)
+    std::atomic<float> fLoad;
+    std::atomic<float> fMinLoad;
+    std::atomic<float> fMaxLoad;
+    std::atomic<uint64_t> fOverruns;
+    std::atomic<uint64_t> fNearMisses;
+
+    DSPLoadMeter(const DSPLoadMeter&) = delete;
+    DSPLoadMeter& operator=(const DSPLoadMeter&) = delete;
+};
+
+} // namespace enlil
+
+#endif // DSP_LOAD_HPP
@@ -6,19 +6,58 @@
  * - Double-buffered frame data (Godot → DPF)
  * - Lock-free input event queue (DPF → Godot)
  * - Resize request handling (DPF → Godot)
+ * - One bridge per editor window when a single engine hosts several
+ * - Per-stage frame timing statistics (see frame_stats.hpp)
+ * - Render quality hints from the host's frame scheduler (DPF → Godot)
+ * - Plugin state changes, e.g. drawn curves (Godot → DPF)
  */
 
 #ifndef FRAME_BRIDGE_HPP
 #define FRAME_BRIDGE_HPP
 
 #include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <cstring>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include "frame_stats.hpp"
+#include "pixel_convert.hpp"
+
 namespace enlil {
 
+// Source pixel layouts accepted by FrameBridge::submitFrame
+// Frames are stored as RGBA8 or BGRA8 (RGB8 is expanded to RGBA8)
+enum PixelFormat {
+    PIXEL_RGBA8,
+    PIXEL_RGB8,
+    PIXEL_BGRA8
+};
+
+// How the alpha channel of a submitted frame is stored and blended
+enum AlphaMode {
+    ALPHA_STRAIGHT,      // Stored as-is, blended with SRC_ALPHA
+    ALPHA_PREMULTIPLIED, // Colour multiplied by alpha on submit, blended with ONE
+    ALPHA_OPAQUE         // Alpha forced to 255, drawn without blending
+};
+
+// Render fidelity requested by the host while audio is under pressure
+enum UIQuality {
+    UI_QUALITY_FULL,    // Engine frame rate, every frame read back
+    UI_QUALITY_REDUCED, // Lower frame rate
+    UI_QUALITY_MINIMAL  // Lowest frame rate, idle frames read back less, animations paused
+};
+
+// Monotonic host time in nanoseconds (steady clock)
+inline uint64_t hostTimeNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
 // Input event types for DPF → Godot communication
 struct InputEvent {
     enum Type {
@@ -35,6 +74,7 @@ struct InputEvent {
     bool pressed;      // Button/key pressed state
     float scrollX;     // Horizontal scroll delta
     float scrollY;     // Vertical scroll delta
+    uint64_t timestamp; // Host time of the (latest merged) event, hostTimeNs()
 };
 
 // Lock-free SPSC ring buffer for input events
@@ -68,6 +108,24 @@ public:
         return true;
     }
 
+    // Pop up to maxCount items with a single acquire/release pair
+    // Returns the number of items written to items
+    size_t popBatch(T* items, size_t maxCount) {
+        size_t currentRead = fReadPos.load(std::memory_order_relaxed);
+        const size_t write = fWritePos.load(std::memory_order_acquire);
+
+        size_t count = 0;
+        while (currentRead != write && count < maxCount) {
+            items[count++] = fBuffer[currentRead];
+            currentRead = (currentRead + 1) % Capacity;
+        }
+
+        if (count > 0) {
+            fReadPos.store(currentRead, std::memory_order_release);
+        }
+        return count;
+    }
+
     bool empty() const {
         return fReadPos.load(std::memory_order_acquire) ==
                fWritePos.load(std::memory_order_acquire);
@@ -86,6 +144,29 @@ private:
 
 using InputEventQueue = InputRingBuffer<InputEvent, 256>;
 
+// Producer-side backlog for events not yet published to the queue.
+// Motion and scroll events wait here so consecutive ones can be merged;
+// button/key edges also wait here if the queue is full instead of being lost.
+// When it fills up, queued motion makes room for them (see pushInputEvent()).
+static constexpr size_t kInputBacklogCapacity = 256;
+
+// Frame slots are allocated in capacity buckets that grow geometrically
+// from the default UI size and never shrink. A window drag through many
+// intermediate sizes therefore only reallocates a handful of times.
+static constexpr size_t kMinFrameCapacity = 600 * 400 * 4;
+
+inline size_t frameCapacityBucket(size_t bytes) {
+    size_t capacity = kMinFrameCapacity;
+    while (capacity < bytes) {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+// Resize requests are coalesced and only handed to Godot once the host
+// has stopped changing the size for this long (e.g. end of a window drag)
+static constexpr uint32_t kDefaultResizeSettleMs = 80;
+
 class FrameBridge {
 public:
     // Get the singleton instance
@@ -94,35 +175,157 @@ public:
         return inst;
     }
 
+    // === Per-editor bridges ===
+    // One Godot engine can host several editor windows. Each window gets its
+    // own bridge (frames, input, size) keyed by a non-zero editor ID; ID 0 is
+    // instance(). Opened and closed by the DPF UI thread, looked up by Godot.
+
+    static FrameBridge& openEditor(uint32_t editorId) {
+        if (editorId == 0) {
+            return instance();
+        }
+
+        EditorRegistry& registry = editorRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        for (auto& entry : registry.bridges) {
+            if (entry.first == editorId) {
+                return *entry.second;
+            }
+        }
+
+        registry.bridges.emplace_back(editorId, std::unique_ptr<FrameBridge>(new FrameBridge()));
+        registry.generation.fetch_add(1, std::memory_order_release);
+        return *registry.bridges.back().second;
+    }
+
+    static void closeEditor(uint32_t editorId) {
+        EditorRegistry& registry = editorRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        for (auto it = registry.bridges.begin(); it != registry.bridges.end(); ++it) {
+            if (it->first == editorId) {
+                registry.bridges.erase(it);
+                registry.generation.fetch_add(1, std::memory_order_release);
+                return;
+            }
+        }
+    }
+
+    // Bridge of an open editor, nullptr once it has been closed
+    static FrameBridge* forEditor(uint32_t editorId) {
+        if (editorId == 0) {
+            return &instance();
+        }
+
+        EditorRegistry& registry = editorRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        for (auto& entry : registry.bridges) {
+            if (entry.first == editorId) {
+                return entry.second.get();
+            }
+        }
+        return nullptr;
+    }
+
+    // Bumped whenever an editor opens or closes
+    static uint32_t getEditorGeneration() {
+        return editorRegistry().generation.load(std::memory_order_acquire);
+    }
+
+    // Copy the open editor IDs, returns how many are open
+    static size_t getEditorIds(uint32_t* ids, size_t maxIds) {
+        EditorRegistry& registry = editorRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        const size_t count = registry.bridges.size();
+        for (size_t i = 0; i < count && i < maxIds; ++i) {
+            ids[i] = registry.bridges[i].first;
+        }
+        return count;
+    }
+
     // === Frame Export (Godot → DPF) ===
 
     // Called by Godot to submit a rendered frame
-    // Copies RGBA data to the back buffer
-    void submitFrame(const uint8_t* rgba, int width, int height) {
-        if (!rgba || width <= 0 || height <= 0) {
+    // Converts the source pixels straight into the back buffer
+    void submitFrame(const uint8_t* pixels, int width, int height,
+                     PixelFormat format = PIXEL_RGBA8,
+                     AlphaMode alpha = ALPHA_STRAIGHT) {
+        if (!pixels || width <= 0 || height <= 0) {
             return;
         }
 
-        size_t dataSize = static_cast<size_t>(width) * height * 4;
+        const size_t pixelCount = static_cast<size_t>(width) * height;
+        uint8_t* dst = beginFrame(width, height);
+
+        if (format == PIXEL_RGB8) {
+            // No alpha channel in the source
+            pixel::expandRGB24(pixels, dst, pixelCount);
+            alpha = ALPHA_OPAQUE;
+        } else if (alpha == ALPHA_PREMULTIPLIED) {
+            pixel::premultiply32(pixels, dst, pixelCount);
+        } else if (alpha == ALPHA_OPAQUE) {
+            pixel::dropAlpha32(pixels, dst, pixelCount);
+        } else {
+            pixel::copy32(pixels, dst, pixelCount);
+        }
 
-        std::lock_guard<std::mutex> lock(fSwapMutex);
+        commitFrame(format == PIXEL_BGRA8 ? PIXEL_BGRA8 : PIXEL_RGBA8, alpha);
+    }
+
+    // Zero-copy frame write: returns the back buffer (at least
+    // width * height * 4 bytes) with the swap lock held. The caller writes
+    // 4-byte pixels into it (e.g. glReadPixels) and must then call
+    // commitFrame() or cancelFrame() on the same thread.
+    uint8_t* beginFrame(int width, int height) {
+        const size_t dataSize = static_cast<size_t>(width) * height * 4;
+
+        fSwapMutex.lock();
 
-        // Resize back buffer if needed
-        if (fBackBuffer.size() != dataSize) {
-            fBackBuffer.resize(dataSize);
+        // Grow back buffer to the next capacity bucket if needed
+        if (fBackBuffer.size() < dataSize) {
+            fBackBuffer.resize(frameCapacityBucket(dataSize));
         }
 
-        // Copy frame data
-        std::memcpy(fBackBuffer.data(), rgba, dataSize);
-        fBackWidth = width;
-        fBackHeight = height;
+        fPendingWidth = width;
+        fPendingHeight = height;
+        return fBackBuffer.data();
+    }
+
+    // Publish the frame written after beginFrame()
+    // format must be PIXEL_RGBA8 or PIXEL_BGRA8
+    // bottomUp marks frames whose first row is the bottom of the image
+    void commitFrame(PixelFormat format, AlphaMode alpha, bool bottomUp = false) {
+        fBackWidth = fPendingWidth;
+        fBackHeight = fPendingHeight;
+        fBackFormat = format;
+        fBackAlpha = alpha;
+        fBackBottomUp = bottomUp;
+
+        // The host never saw the frame this one replaces
+        if (fNewFrame.load(std::memory_order_relaxed)) {
+            fDroppedFrames.fetch_add(1, std::memory_order_relaxed);
+        }
+        fPendingTimings.submitNs = hostTimeNs();
+        fBackTimings = fPendingTimings;
+        fPendingTimings = FrameTimings();
+
         fNewFrame.store(true, std::memory_order_release);
+        fSwapMutex.unlock();
+    }
+
+    // Abandon the frame started with beginFrame()
+    void cancelFrame() {
+        fSwapMutex.unlock();
     }
 
     // Called by DPF to get the current frame data
     // Returns nullptr if no frame available
+    // The buffer may be larger than width * height * 4 (capacity bucket)
     const uint8_t* getFrameData() const {
-        if (fFrontBuffer.empty()) {
+        if (fFrontBuffer.empty() || fFrontWidth <= 0 || fFrontHeight <= 0) {
             return nullptr;
         }
         return fFrontBuffer.data();
@@ -137,6 +340,20 @@ public:
         return fFrontHeight;
     }
 
+    // Layout of the current frame (PIXEL_RGBA8 or PIXEL_BGRA8)
+    PixelFormat getFrameFormat() const {
+        return fFrontFormat;
+    }
+
+    AlphaMode getFrameAlphaMode() const {
+        return fFrontAlpha;
+    }
+
+    // True if the first row of the current frame is the bottom of the image
+    bool isFrameBottomUp() const {
+        return fFrontBottomUp;
+    }
+
     // Check if a new frame is available and swap buffers
     // Returns true if a new frame was swapped in
     bool hasNewFrame() {
@@ -150,22 +367,179 @@ public:
         std::swap(fFrontBuffer, fBackBuffer);
         fFrontWidth = fBackWidth;
         fFrontHeight = fBackHeight;
+        fFrontFormat = fBackFormat;
+        fFrontAlpha = fBackAlpha;
+        fFrontBottomUp = fBackBottomUp;
+        fFrontTimings = fBackTimings;
+        fFrontTimings.swapNs = hostTimeNs();
 
         fNewFrame.store(false, std::memory_order_release);
         return true;
     }
 
+    // === Frame Statistics ===
+
+    // Producer side (the thread that renders and exports frames)
+
+    // Engine iteration that renders the next frame is starting
+    void markRenderStart() {
+        fPendingTimings = FrameTimings();
+        fPendingTimings.renderStartNs = hostTimeNs();
+    }
+
+    // Frame is drawn, export begins
+    void markRenderEnd() {
+        fPendingTimings.renderEndNs = hostTimeNs();
+    }
+
+    // Pixels have been read back into the frame written by beginFrame()
+    void markReadbackEnd() {
+        fPendingTimings.readbackEndNs = hostTimeNs();
+    }
+
+    // A rendered frame was not exported (resize pending, warm-up, readback
+    // interval)
+    void markFrameSkipped() {
+        fSkippedFrames.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Consumer side (DPF UI thread, after hasNewFrame())
+
+    // Current frame was uploaded to the host texture
+    void markFrameUploaded() {
+        fFrontTimings.uploadNs = hostTimeNs();
+    }
+
+    // Current frame was drawn in the host window; records it once
+    void markFramePresented() {
+        if (fFrontTimings.swapNs == 0 || fFrontTimings.presentNs != 0) {
+            return;
+        }
+        fFrontTimings.presentNs = hostTimeNs();
+
+        std::lock_guard<std::mutex> lock(fStatsMutex);
+        fStatsRing.push(fFrontTimings);
+        fPresentedFrames.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Percentiles over the last FrameStatsRing::kCapacity presented frames
+    // plus totals (any thread)
+    void getFrameStats(FrameStats& stats) const {
+        {
+            std::lock_guard<std::mutex> lock(fStatsMutex);
+            fStatsRing.reduce(stats);
+        }
+        stats.presentedFrames = fPresentedFrames.load(std::memory_order_relaxed);
+        stats.droppedFrames = fDroppedFrames.load(std::memory_order_relaxed);
+        stats.skippedFrames = fSkippedFrames.load(std::memory_order_relaxed);
+    }
+
+    void resetFrameStats() {
+        std::lock_guard<std::mutex> lock(fStatsMutex);
+        fStatsRing.clear();
+        fPresentedFrames.store(0, std::memory_order_relaxed);
+        fDroppedFrames.store(0, std::memory_order_relaxed);
+        fSkippedFrames.store(0, std::memory_order_relaxed);
+    }
+
     // === Input Injection (DPF → Godot) ===
 
-    // Push an input event from DPF
+    // Push an input event from DPF (DPF UI thread only)
+    // Consecutive motion events are merged and consecutive scroll deltas
+    // summed while queued; button/key edges are never merged or reordered.
+    // If Godot stops draining and the backlog fills up, the oldest queued
+    // motion is dropped (later events carry newer positions) or the oldest
+    // scroll is summed into a later one, so edges are only lost once the
+    // queue and the backlog hold nothing but edges.
+    // Events reach Godot on the next flushInputEvents() or edge event.
     void pushInputEvent(const InputEvent& event) {
-        fInputQueue.push(event);
+        if (fInputObserver) {
+            fInputObserver(fInputObserverContext, event);
+        }
+
+        const bool coalescable = event.type == InputEvent::MOUSE_MOTION ||
+                                 event.type == InputEvent::SCROLL;
+
+        if (coalescable && fBacklogCount > 0) {
+            InputEvent& last = fBacklog[(fBacklogHead + fBacklogCount - 1) % kInputBacklogCapacity];
+            if (last.type == event.type) {
+                last.x = event.x;
+                last.y = event.y;
+                last.scrollX += event.scrollX;
+                last.scrollY += event.scrollY;
+                last.timestamp = event.timestamp;
+                fInputCoalesced.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+
+        if (fBacklogCount == kInputBacklogCapacity) {
+            publishBacklog();
+            if (fBacklogCount == kInputBacklogCapacity && !makeBacklogRoom()) {
+                // Godot has not drained input for a long time: only edges
+                // are left, a scroll delta can still join the last scroll
+                InputEvent* scroll = event.type == InputEvent::SCROLL
+                    ? findLastBacklog(InputEvent::SCROLL) : nullptr;
+                if (scroll) {
+                    scroll->scrollX += event.scrollX;
+                    scroll->scrollY += event.scrollY;
+                    fInputCoalesced.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    fInputDropped.fetch_add(1, std::memory_order_relaxed);
+                }
+                return;
+            }
+        }
+
+        fBacklog[(fBacklogHead + fBacklogCount) % kInputBacklogCapacity] = event;
+        fBacklogCount++;
+
+        // Edges go out immediately (together with anything queued before them)
+        if (!coalescable) {
+            publishBacklog();
+        }
+    }
+
+    // Called with every pushed event before coalescing, e.g. to record a
+    // session (DPF UI thread only; nullptr removes the observer)
+    typedef void (*InputObserver)(void* context, const InputEvent& event);
+
+    void setInputObserver(InputObserver observer, void* context) {
+        fInputObserver = observer;
+        fInputObserverContext = context;
+    }
+
+    // Publish pending (coalesced) events to Godot (DPF UI thread only)
+    // Call once per frame before Godot processes input
+    void flushInputEvents() {
+        publishBacklog();
+    }
+
+    // Events discarded because both the queue and the backlog were full
+    // (motion, or edges once nothing else was left to make room)
+    uint64_t getDroppedInputCount() const {
+        return fInputDropped.load(std::memory_order_relaxed);
+    }
+
+    // Motion/scroll events merged into an already queued event
+    uint64_t getCoalescedInputCount() const {
+        return fInputCoalesced.load(std::memory_order_relaxed);
     }
 
     // Pop an input event for Godot
     // Returns true if an event was available
     bool popInputEvent(InputEvent& event) {
-        return fInputQueue.pop(event);
+        const bool popped = fInputQueue.pop(event);
+        fInputSinceReadback |= popped;
+        return popped;
+    }
+
+    // Pop up to maxCount input events at once
+    // Returns the number of events written to events
+    size_t popInputEvents(InputEvent* events, size_t maxCount) {
+        const size_t count = fInputQueue.popBatch(events, maxCount);
+        fInputSinceReadback |= count > 0;
+        return count;
     }
 
     // Convenience methods for common input events
@@ -178,6 +552,7 @@ public:
         event.pressed = false;
         event.scrollX = 0;
         event.scrollY = 0;
+        event.timestamp = hostTimeNs();
         pushInputEvent(event);
     }
 
@@ -190,6 +565,7 @@ public:
         event.pressed = pressed;
         event.scrollX = 0;
         event.scrollY = 0;
+        event.timestamp = hostTimeNs();
         pushInputEvent(event);
     }
 
@@ -202,6 +578,7 @@ public:
         event.pressed = false;
         event.scrollX = scrollX;
         event.scrollY = scrollY;
+        event.timestamp = hostTimeNs();
         pushInputEvent(event);
     }
 
@@ -214,35 +591,121 @@ public:
         event.pressed = pressed;
         event.scrollX = 0;
         event.scrollY = 0;
+        event.timestamp = hostTimeNs();
         pushInputEvent(event);
     }
 
     // === Resize Handling (DPF → Godot) ===
 
     // Set the requested viewport size from DPF
+    // Called for every intermediate size during a drag; only the latest
+    // request is kept and it is released once the size has settled
     void setRequestedSize(int width, int height) {
-        fRequestedWidth.store(width, std::memory_order_release);
-        fRequestedHeight.store(height, std::memory_order_release);
+        fRequestedSize.store(packSize(width, height), std::memory_order_release);
+        fResizeRequestTime.store(nowMs(), std::memory_order_release);
         fSizeChanged.store(true, std::memory_order_release);
     }
 
-    // Get requested size if changed
+    // Get requested size if changed and settled
     // Returns true if size changed, fills width/height
     bool getRequestedSize(int& width, int& height) {
         if (!fSizeChanged.load(std::memory_order_acquire)) {
             return false;
         }
 
-        width = fRequestedWidth.load(std::memory_order_acquire);
-        height = fRequestedHeight.load(std::memory_order_acquire);
+        // Still resizing - keep showing the last good frame
+        const uint64_t elapsed = nowMs() - fResizeRequestTime.load(std::memory_order_acquire);
+        if (elapsed < fResizeSettleMs.load(std::memory_order_relaxed)) {
+            return false;
+        }
+
+        // Clear before reading so a concurrent request is never lost
         fSizeChanged.store(false, std::memory_order_release);
+        unpackSize(fRequestedSize.load(std::memory_order_acquire), width, height);
         return true;
     }
 
     // Get current requested size without clearing the changed flag
     void getCurrentSize(int& width, int& height) const {
-        width = fRequestedWidth.load(std::memory_order_acquire);
-        height = fRequestedHeight.load(std::memory_order_acquire);
+        unpackSize(fRequestedSize.load(std::memory_order_acquire), width, height);
+    }
+
+    // True while a resize request is waiting to settle
+    bool isResizePending() const {
+        return fSizeChanged.load(std::memory_order_acquire);
+    }
+
+    // Set how long the requested size must stay unchanged before it is
+    // handed to Godot (0 = forward every request immediately)
+    void setResizeSettleTime(uint32_t ms) {
+        fResizeSettleMs.store(ms, std::memory_order_relaxed);
+    }
+
+    // === Render Quality (DPF → Godot) ===
+
+    // Set by the host's frame scheduler (DPF UI thread), read anywhere
+    void setUIQuality(UIQuality quality) {
+        fUIQuality.store(quality, std::memory_order_relaxed);
+    }
+
+    UIQuality getUIQuality() const {
+        return fUIQuality.load(std::memory_order_relaxed);
+    }
+
+    // Shortest interval between engine frames this editor asks for
+    // (0 = engine default); the engine honours the longest request
+    void setFrameInterval(uint64_t nanoseconds) {
+        fFrameInterval.store(nanoseconds, std::memory_order_relaxed);
+    }
+
+    uint64_t getFrameInterval() const {
+        return fFrameInterval.load(std::memory_order_relaxed);
+    }
+
+    // Read back only every Nth rendered frame unless input arrived since
+    // the last readback (1 = every frame)
+    void setReadbackInterval(uint32_t frames) {
+        fReadbackInterval.store(frames > 0 ? frames : 1, std::memory_order_relaxed);
+    }
+
+    // Whether the frame just drawn should be exported (producer side,
+    // call once per rendered frame)
+    bool shouldReadback() {
+        const uint32_t interval = fReadbackInterval.load(std::memory_order_relaxed);
+        if (interval <= 1 || fInputSinceReadback || ++fFramesSinceReadback >= interval) {
+            fInputSinceReadback = false;
+            fFramesSinceReadback = 0;
+            return true;
+        }
+        return false;
+    }
+
+    // === Plugin State (Godot → DPF) ===
+
+    // Ask the host to set a plugin state (any thread). Changes to a key
+    // that the DPF UI has not taken yet are replaced, so a drag sends only
+    // its latest value.
+    void setStateValue(const std::string& key, const std::string& value) {
+        std::lock_guard<std::mutex> lock(fStateMutex);
+        for (std::pair<std::string, std::string>& pending : fPendingStates) {
+            if (pending.first == key) {
+                pending.second = value;
+                return;
+            }
+        }
+        fPendingStates.emplace_back(key, value);
+    }
+
+    // Oldest pending state change (DPF UI thread); false if there is none
+    bool takeStateValue(std::string& key, std::string& value) {
+        std::lock_guard<std::mutex> lock(fStateMutex);
+        if (fPendingStates.empty()) {
+            return false;
+        }
+        key = std::move(fPendingStates.front().first);
+        value = std::move(fPendingStates.front().second);
+        fPendingStates.erase(fPendingStates.begin());
+        return true;
     }
 
 private:
@@ -251,12 +714,117 @@ private:
         , fFrontHeight(0)
         , fBackWidth(0)
         , fBackHeight(0)
+        , fFrontFormat(PIXEL_RGBA8)
+        , fBackFormat(PIXEL_RGBA8)
+        , fFrontAlpha(ALPHA_STRAIGHT)
+        , fBackAlpha(ALPHA_STRAIGHT)
+        , fFrontBottomUp(false)
+        , fBackBottomUp(false)
+        , fPendingWidth(0)
+        , fPendingHeight(0)
         , fNewFrame(false)
-        , fRequestedWidth(600)
-        , fRequestedHeight(400)
+        , fPendingTimings()
+        , fBackTimings()
+        , fFrontTimings()
+        , fPresentedFrames(0)
+        , fDroppedFrames(0)
+        , fSkippedFrames(0)
+        , fRequestedSize(packSize(600, 400))
+        , fResizeRequestTime(0)
+        , fResizeSettleMs(kDefaultResizeSettleMs)
         , fSizeChanged(false)
+        , fBacklogHead(0)
+        , fBacklogCount(0)
+        , fInputDropped(0)
+        , fInputCoalesced(0)
+        , fInputObserver(nullptr)
+        , fInputObserverContext(nullptr)
+        , fUIQuality(UI_QUALITY_FULL)
+        , fFrameInterval(0)
+        , fReadbackInterval(1)
+        , fFramesSinceReadback(0)
+        , fInputSinceReadback(false)
     {}
 
+    // Move backlog events into the queue while it has room (producer side)
+    void publishBacklog() {
+        while (fBacklogCount > 0 && fInputQueue.push(fBacklog[fBacklogHead])) {
+            fBacklogHead = (fBacklogHead + 1) % kInputBacklogCapacity;
+            fBacklogCount--;
+        }
+    }
+
+    InputEvent& backlogAt(size_t i) {
+        return fBacklog[(fBacklogHead + i) % kInputBacklogCapacity];
+    }
+
+    InputEvent* findLastBacklog(InputEvent::Type type) {
+        for (size_t i = fBacklogCount; i-- > 0;) {
+            if (backlogAt(i).type == type) {
+                return &backlogAt(i);
+            }
+        }
+        return nullptr;
+    }
+
+    // Free one backlog slot without losing an edge: drop the oldest motion,
+    // or sum the oldest scroll into the next one. False if neither exists.
+    bool makeBacklogRoom() {
+        size_t scroll = fBacklogCount;
+        for (size_t i = 0; i < fBacklogCount; ++i) {
+            const InputEvent::Type type = backlogAt(i).type;
+            if (type == InputEvent::MOUSE_MOTION) {
+                eraseBacklog(i);
+                fInputDropped.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+            if (type == InputEvent::SCROLL) {
+                if (scroll == fBacklogCount) {
+                    scroll = i;
+                    continue;
+                }
+                backlogAt(i).scrollX += backlogAt(scroll).scrollX;
+                backlogAt(i).scrollY += backlogAt(scroll).scrollY;
+                eraseBacklog(scroll);
+                fInputCoalesced.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void eraseBacklog(size_t i) {
+        for (; i + 1 < fBacklogCount; ++i) {
+            backlogAt(i) = backlogAt(i + 1);
+        }
+        fBacklogCount--;
+    }
+
+    static uint64_t packSize(int width, int height) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(width)) << 32) |
+               static_cast<uint32_t>(height);
+    }
+
+    static void unpackSize(uint64_t packed, int& width, int& height) {
+        width = static_cast<int>(packed >> 32);
+        height = static_cast<int>(packed & 0xFFFFFFFFu);
+    }
+
+    static uint64_t nowMs() {
+        return hostTimeNs() / 1000000u;
+    }
+
+    struct EditorRegistry {
+        std::mutex mutex;
+        std::vector<std::pair<uint32_t, std::unique_ptr<FrameBridge>>> bridges;
+        std::atomic<uint32_t> generation{0};
+    };
+
+    static EditorRegistry& editorRegistry() {
+        static EditorRegistry registry;
+        return registry;
+    }
+
     // Prevent copying
     FrameBridge(const FrameBridge&) = delete;
     FrameBridge& operator=(const FrameBridge&) = delete;
@@ -266,16 +834,59 @@ private:
     std::vector<uint8_t> fBackBuffer;
     int fFrontWidth, fFrontHeight;
     int fBackWidth, fBackHeight;
+    PixelFormat fFrontFormat, fBackFormat;
+    AlphaMode fFrontAlpha, fBackAlpha;
+    bool fFrontBottomUp, fBackBottomUp;
+    int fPendingWidth, fPendingHeight;
     std::atomic<bool> fNewFrame;
     std::mutex fSwapMutex;
 
+    // Frame timings: pending (producer), back (under fSwapMutex), front (consumer)
+    FrameTimings fPendingTimings;
+    FrameTimings fBackTimings;
+    FrameTimings fFrontTimings;
+
+    // Presented frames
+    mutable std::mutex fStatsMutex;
+    FrameStatsRing fStatsRing;
+    std::atomic<uint64_t> fPresentedFrames;
+    std::atomic<uint64_t> fDroppedFrames;
+    std::atomic<uint64_t> fSkippedFrames;
+
     // Input event queue
     InputEventQueue fInputQueue;
 
-    // Resize request
-    std::atomic<int> fRequestedWidth;
-    std::atomic<int> fRequestedHeight;
+    // Resize request (width/height packed so they never tear)
+    std::atomic<uint64_t> fRequestedSize;
+    std::atomic<uint64_t> fResizeRequestTime;
+    std::atomic<uint32_t> fResizeSettleMs;
     std::atomic<bool> fSizeChanged;
+
+    // Unpublished events (DPF UI thread only)
+    InputEvent fBacklog[kInputBacklogCapacity];
+    size_t fBacklogHead;
+    size_t fBacklogCount;
+
+    // Input accounting (written by DPF, read anywhere)
+    std::atomic<uint64_t> fInputDropped;
+    std::atomic<uint64_t> fInputCoalesced;
+
+    // Input observer (DPF UI thread only)
+    InputObserver fInputObserver;
+    void* fInputObserverContext;
+
+    // Render quality hints (written by DPF, read anywhere)
+    std::atomic<UIQuality> fUIQuality;
+    std::atomic<uint64_t> fFrameInterval;
+    std::atomic<uint32_t> fReadbackInterval;
+
+    // Readback pacing (producer side)
+    uint32_t fFramesSinceReadback;
+    bool fInputSinceReadback;
+
+    // State changes not yet handed to the plugin
+    std::mutex fStateMutex;
+    std::vector<std::pair<std::string, std::string>> fPendingStates;
 };
 
 } // namespace enlil
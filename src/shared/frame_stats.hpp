@@ -0,0 +1,200 @@
+/*
+ * Frame Stats - Per-stage timing of the Godot → DPF frame pipeline
+ * Part of the Enlil/GodotVST Framework
+ *
+ * Every frame carries a set of host timestamps through the pipeline:
+ *
+ *   renderStart   engine iteration begins (GodotEngineHost)
+ *   renderEnd     frame drawn, export starts (FrameExporter)
+ *   readbackEnd   pixels are in the back buffer (FrameExporter)
+ *   submit        frame published, commitFrame() (FrameBridge)
+ *   swap          picked up by the host, hasNewFrame() (FrameBridge)
+ *   upload        texture updated (FatSatUI)
+ *   present       drawn in the host window (FatSatUI)
+ *
+ * Presented frames are kept in a fixed-size ring; a snapshot reduces the
+ * ring to p50/p95/p99 per stage, effective FPS and frame age at display.
+ * A timestamp of 0 means the stage did not happen for that frame (e.g.
+ * frames submitted from GDScript have no renderStart), and the stages
+ * that depend on it are left out of the percentiles.
+ */
+
+#ifndef FRAME_STATS_HPP
+#define FRAME_STATS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace enlil {
+
+// Timestamps of one frame, hostTimeNs()
+struct FrameTimings {
+    uint64_t renderStartNs;
+    uint64_t renderEndNs;
+    uint64_t readbackEndNs;
+    uint64_t submitNs;
+    uint64_t swapNs;
+    uint64_t uploadNs;
+    uint64_t presentNs;
+};
+
+// Pipeline stages, each measured from the previous timestamp
+enum FrameStage {
+    FRAME_STAGE_RENDER,   // renderStart → renderEnd
+    FRAME_STAGE_READBACK, // renderEnd → readbackEnd
+    FRAME_STAGE_SUBMIT,   // readbackEnd → submit
+    FRAME_STAGE_SWAP,     // submit → swap (waiting for the host)
+    FRAME_STAGE_UPLOAD,   // swap → upload
+    FRAME_STAGE_PRESENT,  // upload → present
+    FRAME_STAGE_COUNT
+};
+
+inline const char* frameStageName(FrameStage stage) {
+    switch (stage) {
+        case FRAME_STAGE_RENDER:   return "render";
+        case FRAME_STAGE_READBACK: return "readback";
+        case FRAME_STAGE_SUBMIT:   return "submit";
+        case FRAME_STAGE_SWAP:     return "swap";
+        case FRAME_STAGE_UPLOAD:   return "upload";
+        case FRAME_STAGE_PRESENT:  return "present";
+        default:                   return "unknown";
+    }
+}
+
+// Percentiles in microseconds (0 when no frame measured the value)
+struct FramePercentiles {
+    double p50Us;
+    double p95Us;
+    double p99Us;
+};
+
+struct FrameStats {
+    FramePercentiles stages[FRAME_STAGE_COUNT];
+
+    // renderEnd → present: how old the image is when the user sees it
+    FramePercentiles age;
+
+    // Presented frames per second over the ring
+    double fps;
+
+    // Frames in the ring
+    uint32_t frameCount;
+
+    // Totals since the bridge was opened
+    uint64_t presentedFrames;
+    uint64_t droppedFrames; // Submitted but replaced before the host took them
+    uint64_t skippedFrames; // Rendered but not exported (resize pending, warm-up)
+};
+
+// Fixed-size ring of presented frames (not thread-safe; FrameBridge locks)
+class FrameStatsRing {
+public:
+    static constexpr size_t kCapacity = 240;
+
+    FrameStatsRing() : fHead(0), fCount(0) {}
+
+    void push(const FrameTimings& timings) {
+        fFrames[fHead] = timings;
+        fHead = (fHead + 1) % kCapacity;
+        if (fCount < kCapacity) {
+            fCount++;
+        }
+    }
+
+    void clear() {
+        fHead = 0;
+        fCount = 0;
+    }
+
+    size_t size() const { return fCount; }
+
+    // Reduce the ring to percentiles and FPS (counters are left untouched)
+    void reduce(FrameStats& stats) const {
+        uint64_t values[kCapacity];
+
+        for (int stage = 0; stage < FRAME_STAGE_COUNT; ++stage) {
+            size_t n = 0;
+            for (size_t i = 0; i < fCount; ++i) {
+                const FrameTimings& frame = fFrames[i];
+                const uint64_t from = stageStart(frame, static_cast<FrameStage>(stage));
+                const uint64_t to = stageEnd(frame, static_cast<FrameStage>(stage));
+                if (from != 0 && to >= from) {
+                    values[n++] = to - from;
+                }
+            }
+            stats.stages[stage] = percentiles(values, n);
+        }
+
+        size_t n = 0;
+        for (size_t i = 0; i < fCount; ++i) {
+            const FrameTimings& frame = fFrames[i];
+            if (frame.renderEndNs != 0 && frame.presentNs >= frame.renderEndNs) {
+                values[n++] = frame.presentNs - frame.renderEndNs;
+            }
+        }
+        stats.age = percentiles(values, n);
+
+        stats.fps = 0.0;
+        if (fCount >= 2) {
+            const uint64_t newest = fFrames[(fHead + kCapacity - 1) % kCapacity].presentNs;
+            const uint64_t oldest = fFrames[(fHead + kCapacity - fCount) % kCapacity].presentNs;
+            if (newest > oldest) {
+                stats.fps = (fCount - 1) * 1.0e9 / static_cast<double>(newest - oldest);
+            }
+        }
+
+        stats.frameCount = static_cast<uint32_t>(fCount);
+    }
+
+private:
+    static uint64_t stageStart(const FrameTimings& frame, FrameStage stage) {
+        switch (stage) {
+            case FRAME_STAGE_RENDER:   return frame.renderStartNs;
+            case FRAME_STAGE_READBACK: return frame.renderEndNs;
+            case FRAME_STAGE_SUBMIT:   return frame.readbackEndNs;
+            case FRAME_STAGE_SWAP:     return frame.submitNs;
+            case FRAME_STAGE_UPLOAD:   return frame.swapNs;
+            case FRAME_STAGE_PRESENT:  return frame.uploadNs;
+            default:                   return 0;
+        }
+    }
+
+    static uint64_t stageEnd(const FrameTimings& frame, FrameStage stage) {
+        switch (stage) {
+            case FRAME_STAGE_RENDER:   return frame.renderEndNs;
+            case FRAME_STAGE_READBACK: return frame.readbackEndNs;
+            case FRAME_STAGE_SUBMIT:   return frame.submitNs;
+            case FRAME_STAGE_SWAP:     return frame.swapNs;
+            case FRAME_STAGE_UPLOAD:   return frame.uploadNs;
+            case FRAME_STAGE_PRESENT:  return frame.presentNs;
+            default:                   return 0;
+        }
+    }
+
+    // Nearest-rank percentiles; reorders values
+    static FramePercentiles percentiles(uint64_t* values, size_t n) {
+        FramePercentiles result = {0.0, 0.0, 0.0};
+        if (n == 0) {
+            return result;
+        }
+        result.p50Us = rank(values, n, 50) / 1000.0;
+        result.p95Us = rank(values, n, 95) / 1000.0;
+        result.p99Us = rank(values, n, 99) / 1000.0;
+        return result;
+    }
+
+    static uint64_t rank(uint64_t* values, size_t n, size_t percent) {
+        const size_t index = std::min(n - 1, (n * percent + 99) / 100 - 1);
+        std::nth_element(values, values + index, values + n);
+        return values[index];
+    }
+
+    FrameTimings fFrames[kCapacity];
+    size_t fHead;
+    size_t fCount;
+};
+
+} // namespace enlil
+
+#endif // FRAME_STATS_HPP
@@ -1,12 +1,58 @@
+/*
+ * LibGodot Benchmark Driver - Per-frame cost of the FatSat UI in LibGodot
+ * Part of the Enlil/GodotVST Framework
+ *
+ * Boots LibGodot on a project and calls iteration() a fixed number of
+ * times. With the FatSat project (src/godot), the FatSat GDExtension classes
+ * are registered in-process like the plugin does, and one editor is opened
+ * through the FrameBridge so EditorSpawner instantiates main.tscn's editor
+ * scene, which is then resized to every requested viewport size.
+ *
+ * Each frame's wall time is split with Godot's own measurements:
+ *   process  Performance TIME_PROCESS (idle callbacks, GDScript _process)
+ *   physics  Performance TIME_PHYSICS_PROCESS
+ *   render   RenderingServer CPU time: frame setup + all measured viewports
+ *   other    the rest of iteration() (input, message queue, GPU sync, ...)
+ *
+ * Variants, one run each, tagged in the output:
+ *   --lib         stripped vs. full LibGodot build (library path + size)
+ *   --ui-logic    gdscript: PluginUI runs its _process() as shipped
+ *                 disabled: PluginUI processing off, the floor a native
+ *                 implementation of the UI logic could reach
+ *   --sizes       editor viewport sizes
+ *
+ * Usage: libgodot_test [--lib PATH] [--project DIR] [--frames N] [--warmup N]
+ *                      [--sizes WxH,...] [--ui-logic gdscript|disabled]
+ *                      [--label NAME] [--display-driver NAME] [--json PATH]
+ *
+ * With --frames 0 it only boots the project and runs until it quits.
+ */
+
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <dlfcn.h>
+#include <sys/stat.h>
 #include <string>
 #include <vector>
 
 #include <godot_cpp/core/defs.hpp>
 #include <godot_cpp/godot.hpp>
+#include <godot_cpp/classes/engine.hpp>
 #include <godot_cpp/classes/godot_instance.hpp>
+#include <godot_cpp/classes/performance.hpp>
+#include <godot_cpp/classes/rendering_server.hpp>
+#include <godot_cpp/classes/scene_tree.hpp>
+#include <godot_cpp/classes/viewport.hpp>
+#include <godot_cpp/classes/window.hpp>
+
+#include "../bench/bench.hpp"
+#include "../frame_bridge.hpp"
+#include "../../bridge/editor_spawner.hpp"
+#include "../../bridge/fatsat_bridge.hpp"
+#include "../../bridge/frame_bridge_gd.hpp"
+#include "../../bridge/frame_exporter.hpp"
+#include "../../bridge/input_injector.hpp"
 
 
 #ifdef __APPLE__
@@ -22,6 +68,12 @@ static void initialize_default_module(godot::ModuleInitializationLevel p_level)
         return;
     }
 
+    // Same classes the plugin registers, so the FatSat project loads
+    godot::ClassDB::register_class<godot::FatSatBridge>();
+    godot::ClassDB::register_class<godot::FrameBridgeGD>();
+    godot::ClassDB::register_class<godot::FrameExporter>();
+    godot::ClassDB::register_class<godot::InputInjector>();
+    godot::ClassDB::register_class<godot::EditorSpawner>();
 }
 
 static void uninitialize_default_module(godot::ModuleInitializationLevel p_level) {
@@ -54,14 +106,14 @@ public:
         if (func_libgodot_create_godot_instance == nullptr) {
             fprintf(stderr, "Error acquiring function: %s\n", dlerror());
             dlclose(handle);
-            handle == nullptr;
+            handle = nullptr;
             return;
         }
         *(void**)(&func_libgodot_destroy_godot_instance) = dlsym(handle, "libgodot_destroy_godot_instance");
         if (func_libgodot_destroy_godot_instance == nullptr) {
             fprintf(stderr, "Error acquiring function: %s\n", dlerror());
             dlclose(handle);
-            handle == nullptr;
+            handle = nullptr;
             return;
         }
     }
@@ -98,16 +150,256 @@ private:
     void (*func_libgodot_destroy_godot_instance)(GDExtensionObjectPtr) = nullptr;
 };
 
+// Editor ID the benchmark opens in the FrameBridge registry
+static const uint32_t BENCH_EDITOR_ID = 1;
+
+struct BenchOptions {
+    std::string lib_path = LIBGODOT_LIBRARY_NAME;
+    std::string project_path = "./project/";
+    std::string label = "default";
+    std::string ui_logic = "gdscript";
+    std::string display_driver;
+    std::string json_path;
+    int frames = 0;
+    int warmup = 60;
+    std::vector<std::pair<int, int>> sizes = { { 600, 400 } };
+};
+
+struct FrameSamples {
+    std::vector<double> total_us;
+    std::vector<double> process_us;
+    std::vector<double> physics_us;
+    std::vector<double> render_us;
+    std::vector<double> other_us;
+};
+
+struct SizeResult {
+    int width = 0;
+    int height = 0;
+    double p50[5] = {};
+    double p99[5] = {};
+    double mean_total_us = 0.0;
+};
+
+static const char *SAMPLE_NAMES[5] = { "total", "process", "physics", "render", "other" };
+
+static bool parse_sizes(const char *p_text, std::vector<std::pair<int, int>> &r_sizes) {
+    r_sizes.clear();
+    std::string list(p_text);
+    size_t start = 0;
+    while (start <= list.size()) {
+        size_t end = list.find(',', start);
+        if (end == std::string::npos) {
+            end = list.size();
+        }
+        int width = 0;
+        int height = 0;
+        if (sscanf(list.substr(start, end - start).c_str(), "%dx%d", &width, &height) != 2 || width <= 0 || height <= 0) {
+            return false;
+        }
+        r_sizes.emplace_back(width, height);
+        start = end + 1;
+    }
+    return !r_sizes.empty();
+}
+
+static bool parse_options(int argc, char **argv, BenchOptions &r_options) {
+    for (int i = 1; i < argc; ++i) {
+        const bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--lib") == 0 && has_value) {
+            r_options.lib_path = argv[++i];
+        } else if (strcmp(argv[i], "--project") == 0 && has_value) {
+            r_options.project_path = argv[++i];
+        } else if (strcmp(argv[i], "--frames") == 0 && has_value) {
+            r_options.frames = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--warmup") == 0 && has_value) {
+            r_options.warmup = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--sizes") == 0 && has_value) {
+            if (!parse_sizes(argv[++i], r_options.sizes)) {
+                fprintf(stderr, "Invalid size list: %s\n", argv[i]);
+                return false;
+            }
+        } else if (strcmp(argv[i], "--ui-logic") == 0 && has_value) {
+            r_options.ui_logic = argv[++i];
+            if (r_options.ui_logic != "gdscript" && r_options.ui_logic != "disabled") {
+                fprintf(stderr, "Unknown --ui-logic %s (gdscript or disabled)\n", argv[i]);
+                return false;
+            }
+        } else if (strcmp(argv[i], "--label") == 0 && has_value) {
+            r_options.label = argv[++i];
+        } else if (strcmp(argv[i], "--display-driver") == 0 && has_value) {
+            r_options.display_driver = argv[++i];
+        } else if (strcmp(argv[i], "--json") == 0 && has_value) {
+            r_options.json_path = argv[++i];
+        } else {
+            fprintf(stderr,
+                    "Usage: %s [--lib PATH] [--project DIR] [--frames N] [--warmup N]\n"
+                    "          [--sizes WxH,...] [--ui-logic gdscript|disabled]\n"
+                    "          [--label NAME] [--display-driver NAME] [--json PATH]\n",
+                    argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+static godot::SceneTree *get_scene_tree() {
+    return godot::Object::cast_to<godot::SceneTree>(godot::Engine::get_singleton()->get_main_loop());
+}
+
+// Turn on CPU render time measurement for every viewport in the tree
+// Returns the viewports so their times can be read back each frame
+static void collect_viewports(godot::Node *p_node, std::vector<godot::RID> &r_viewports) {
+    if (godot::Viewport *viewport = godot::Object::cast_to<godot::Viewport>(p_node)) {
+        const godot::RID rid = viewport->get_viewport_rid();
+        godot::RenderingServer::get_singleton()->viewport_set_measure_render_time(rid, true);
+        r_viewports.push_back(rid);
+    }
+    for (int i = 0; i < p_node->get_child_count(); ++i) {
+        collect_viewports(p_node->get_child(i), r_viewports);
+    }
+}
+
+// Apply the UI logic variant to the spawned editor's PluginUI
+static void apply_ui_logic(godot::Node *p_root, const std::string &p_ui_logic) {
+    godot::TypedArray<godot::Node> nodes = p_root->find_children("PluginUI", "", true, false);
+    for (int i = 0; i < nodes.size(); ++i) {
+        godot::Node *node = godot::Object::cast_to<godot::Node>(nodes[i]);
+        if (node) {
+            node->set_process(p_ui_logic == "gdscript");
+        }
+    }
+}
+
+static double render_cpu_ms(const std::vector<godot::RID> &p_viewports) {
+    godot::RenderingServer *rs = godot::RenderingServer::get_singleton();
+    double ms = rs->get_frame_setup_time_cpu();
+    for (const godot::RID &rid : p_viewports) {
+        ms += rs->viewport_get_measured_render_time_cpu(rid);
+    }
+    return ms;
+}
+
+static bool run_size(godot::GodotInstance *p_instance, const BenchOptions &p_options, int p_width, int p_height, SizeResult &r_result) {
+    enlil::FrameBridge *bridge = enlil::FrameBridge::forEditor(BENCH_EDITOR_ID);
+    if (bridge) {
+        bridge->setRequestedSize(p_width, p_height);
+    }
+
+    // Warm up: the resize, editor spawn and shader compiles land here
+    for (int i = 0; i < p_options.warmup; ++i) {
+        if (p_instance->iteration()) {
+            return false;
+        }
+        if (bridge) {
+            bridge->hasNewFrame();
+        }
+    }
+
+    godot::SceneTree *tree = get_scene_tree();
+    if (!tree) {
+        fprintf(stderr, "No SceneTree main loop\n");
+        return false;
+    }
+
+    apply_ui_logic(tree->get_root(), p_options.ui_logic);
+
+    std::vector<godot::RID> viewports;
+    collect_viewports(tree->get_root(), viewports);
+
+    godot::Performance *performance = godot::Performance::get_singleton();
+
+    FrameSamples samples;
+    double total_sum = 0.0;
+    for (int i = 0; i < p_options.frames; ++i) {
+        const uint64_t start = enlil::bench::nowNs();
+        if (p_instance->iteration()) {
+            return false;
+        }
+        const double total_us = (enlil::bench::nowNs() - start) / 1000.0;
+
+        // The host would take the frame here
+        if (bridge) {
+            bridge->hasNewFrame();
+        }
+
+        const double process_us = performance->get_monitor(godot::Performance::TIME_PROCESS) * 1.0e6;
+        const double physics_us = performance->get_monitor(godot::Performance::TIME_PHYSICS_PROCESS) * 1.0e6;
+        const double render_us = render_cpu_ms(viewports) * 1000.0;
+
+        samples.total_us.push_back(total_us);
+        samples.process_us.push_back(process_us);
+        samples.physics_us.push_back(physics_us);
+        samples.render_us.push_back(render_us);
+        samples.other_us.push_back(std::max(0.0, total_us - process_us - physics_us - render_us));
+        total_sum += total_us;
+    }
+
+    std::vector<double> *columns[5] = { &samples.total_us, &samples.process_us, &samples.physics_us, &samples.render_us, &samples.other_us };
+    r_result.width = p_width;
+    r_result.height = p_height;
+    r_result.mean_total_us = p_options.frames > 0 ? total_sum / p_options.frames : 0.0;
+    for (int i = 0; i < 5; ++i) {
+        r_result.p50[i] = enlil::bench::percentile(*columns[i], 50.0);
+        r_result.p99[i] = enlil::bench::percentile(*columns[i], 99.0);
+    }
+    return true;
+}
+
+static void print_result(const SizeResult &p_result) {
+    printf("\n%dx%d: mean %.1f us/frame\n", p_result.width, p_result.height, p_result.mean_total_us);
+    printf("  %-8s %10s %10s\n", "", "p50 us", "p99 us");
+    for (int i = 0; i < 5; ++i) {
+        printf("  %-8s %10.1f %10.1f\n", SAMPLE_NAMES[i], p_result.p50[i], p_result.p99[i]);
+    }
+    fflush(stdout);
+}
+
+static bool write_json(const BenchOptions &p_options, const std::vector<SizeResult> &p_results) {
+    FILE *file = fopen(p_options.json_path.c_str(), "w");
+    if (file == nullptr) {
+        fprintf(stderr, "Cannot open %s for writing\n", p_options.json_path.c_str());
+        return false;
+    }
+
+    struct stat lib_stat = {};
+    const long long lib_bytes = stat(p_options.lib_path.c_str(), &lib_stat) == 0 ? (long long)lib_stat.st_size : -1;
+
+    fprintf(file, "{\n  \"label\": \"%s\",\n  \"lib\": \"%s\",\n  \"lib_bytes\": %lld,\n",
+            p_options.label.c_str(), p_options.lib_path.c_str(), lib_bytes);
+    fprintf(file, "  \"project\": \"%s\",\n  \"ui_logic\": \"%s\",\n  \"frames\": %d,\n  \"sizes\": [\n",
+            p_options.project_path.c_str(), p_options.ui_logic.c_str(), p_options.frames);
+    for (size_t i = 0; i < p_results.size(); ++i) {
+        const SizeResult &result = p_results[i];
+        fprintf(file, "    {\"width\": %d, \"height\": %d, \"mean_total_us\": %.2f", result.width, result.height, result.mean_total_us);
+        for (int j = 0; j < 5; ++j) {
+            fprintf(file, ", \"%s_p50_us\": %.2f, \"%s_p99_us\": %.2f", SAMPLE_NAMES[j], result.p50[j], SAMPLE_NAMES[j], result.p99[j]);
+        }
+        fprintf(file, "}%s\n", i + 1 < p_results.size() ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+    fclose(file);
+    return true;
+}
+
 int main(int argc, char **argv) {
+    BenchOptions options;
+    if (!parse_options(argc, argv, options)) {
+        return EXIT_FAILURE;
+    }
 
-    LibGodot libgodot;
+    LibGodot libgodot(options.lib_path);
 
     std::string program;
     if (argc > 0) {
         program = std::string(argv[0]);
     }
-    // Path to the test project (relative to where the binary is run from)
-    std::vector<std::string> args = { program, "--path", "./project/", "--rendering-method", "gl_compatibility", "--rendering-driver", "opengl3" };
+    // Path to the project (relative to where the binary is run from)
+    std::vector<std::string> args = { program, "--path", options.project_path, "--rendering-method", "gl_compatibility", "--rendering-driver", "opengl3" };
+    if (!options.display_driver.empty()) {
+        args.push_back("--display-driver");
+        args.push_back(options.display_driver);
+    }
 
     std::vector<char*> argvs;
     for (const auto& arg : args) {
@@ -115,15 +407,48 @@ int main(int argc, char **argv) {
     }
     argvs.push_back(nullptr);
 
-    godot::GodotInstance *instance = libgodot.create_godot_instance(argvs.size(), argvs.data());
+    // Opened before start() so EditorSpawner finds it on its first frame
+    enlil::FrameBridge &bridge = enlil::FrameBridge::openEditor(BENCH_EDITOR_ID);
+    bridge.setResizeSettleTime(0);
+
+    godot::GodotInstance *instance = libgodot.create_godot_instance(argvs.size() - 1, argvs.data());
     if (instance == nullptr) {
         fprintf(stderr, "Error creating Godot instance\n");
         return EXIT_FAILURE;
     }
 
     instance->start();
-    while (!instance->iteration()) {}
+
+    // Smoke test: run until the project quits
+    if (options.frames <= 0) {
+        while (!instance->iteration()) {}
+        libgodot.destroy_godot_instance(instance);
+        enlil::FrameBridge::closeEditor(BENCH_EDITOR_ID);
+        return EXIT_SUCCESS;
+    }
+
+    printf("[%s] %s, ui logic %s, %d frames per size\n",
+           options.label.c_str(), options.lib_path.c_str(), options.ui_logic.c_str(), options.frames);
+
+    std::vector<SizeResult> results;
+    bool ok = true;
+    for (const auto &size : options.sizes) {
+        SizeResult result;
+        if (!run_size(instance, options, size.first, size.second, result)) {
+            fprintf(stderr, "Project quit during the %dx%d run\n", size.first, size.second);
+            ok = false;
+            break;
+        }
+        print_result(result);
+        results.push_back(result);
+    }
+
     libgodot.destroy_godot_instance(instance);
+    enlil::FrameBridge::closeEditor(BENCH_EDITOR_ID);
+
+    if (ok && !options.json_path.empty()) {
+        ok = write_json(options, results);
+    }
 
-    return EXIT_SUCCESS;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
 }
@@ -0,0 +1,316 @@
+/*
+ * Lookahead Limiter - Stereo-linked brickwall ceiling with true-peak detection
+ * Part of the Enlil/GodotVST Framework
+ *
+ * The signal is delayed by the lookahead so the gain can come down before
+ * a peak arrives instead of clipping it:
+ * - detection: the channels' peak per sample, optionally true peak (4x
+ *   polyphase interpolation, 8 taps per phase) to catch inter-sample peaks
+ * - required gain ceiling / peak, held over the lookahead window with a
+ *   monotonic deque (sliding minimum, O(1) amortized per sample)
+ * - release: the held gain may only rise with a one-pole at kReleaseSeconds
+ * - attack: a running-sum box filter over the same window turns the held
+ *   gain into a linear ramp that reaches the required gain exactly on the
+ *   peak, so the output never exceeds the ceiling
+ *
+ * Latency is the lookahead plus the interpolator's kTruePeakDelay, whether
+ * true-peak detection is on or not, so toggling it never moves the signal.
+ * All buffers are sized for kMaxLookahead at construction; the
+ * interpolator's taps are shared by every limiter in the process
+ * (DSPTableCache).
+ *
+ * Audio thread only, except for construction and setSampleRate().
+ */
+
+#ifndef LIMITER_HPP
+#define LIMITER_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#include "table_cache.hpp"
+
+namespace enlil {
+
+class LookaheadLimiter {
+public:
+    static constexpr uint32_t kMaxChannels = 2;
+
+    // Lookahead and release defaults
+    static constexpr double kLookaheadSeconds = 0.0015;
+    static constexpr double kReleaseSeconds = 0.05;
+
+    // Longest lookahead in samples (1.5 ms at 384 kHz fits)
+    static constexpr uint32_t kMaxLookahead = 1023;
+
+    // The interpolator looks this many samples ahead of the detected sample
+    static constexpr uint32_t kTruePeakTaps = 8;
+    static constexpr uint32_t kTruePeakDelay = kTruePeakTaps / 2;
+
+    LookaheadLimiter()
+        : fCeiling(0.989f),
+          fTruePeak(true),
+          fLookahead(0),
+          fWindow(1),
+          fInvWindow(1.0),
+          fReleaseCoeff(0.0f),
+          fPosition(0)
+    {
+        const DSPTableKey key = {DSP_TABLE_TRUE_PEAK, kPhases, kTruePeakTaps, 0.0, 0};
+        fInterpolator = DSPTableCache::instance().acquire<Interpolator>(key, designInterpolator);
+        setSampleRate(48000.0);
+    }
+
+    // Recomputes lookahead and release and clears the state; not while
+    // process() is running
+    void setSampleRate(double sampleRate) {
+        if (sampleRate <= 0.0) {
+            return;
+        }
+        fLookahead = std::min(kMaxLookahead,
+                              static_cast<uint32_t>(std::lround(kLookaheadSeconds * sampleRate)));
+        fWindow = fLookahead + 1;
+        fInvWindow = 1.0 / fWindow;
+        fReleaseCoeff = static_cast<float>(1.0 - std::exp(-1.0 / (kReleaseSeconds * sampleRate)));
+        reset();
+    }
+
+    void reset() {
+        std::memset(fHistory, 0, sizeof(fHistory));
+        std::memset(fDelay, 0, sizeof(fDelay));
+        std::fill(fBox, fBox + kMaxLookahead + 1, 1.0f);
+        fBoxIndex = 0;
+        fBoxSum = fWindow;
+        fDequeHead = 0;
+        fDequeTail = 0;
+        fReleased = 1.0f;
+        fUnityRun = fWindow;
+        fPosition = 0;
+        fGainReduction = 1.0f;
+    }
+
+    // Linear ceiling (default 0.989, -0.1 dBFS)
+    void setCeiling(float ceiling) { fCeiling = ceiling; }
+
+    // Detect inter-sample peaks (24 extra multiply-adds per channel and
+    // sample, only where the signal comes near the ceiling)
+    void setTruePeak(bool enabled) { fTruePeak = enabled; }
+
+    uint32_t getLatency() const { return fLookahead + kTruePeakDelay; }
+
+    // Lowest gain applied in the last process() call (1 = no limiting)
+    float getGainReduction() const { return fGainReduction; }
+
+    // Limit channels (at most kMaxChannels) in place, gain linked
+    void process(float* const* io, uint32_t channels, uint32_t frames) {
+        channels = std::min(channels, kMaxChannels);
+        const uint32_t latency = getLatency();
+        float lowestGain = 1.0f;
+
+        for (uint32_t i = 0; i < frames; ++i) {
+            const uint32_t position = fPosition;
+            const uint32_t history = position & kHistoryMask;
+
+            // Peak of the sample kTruePeakDelay back
+            float peak = 0.0f;
+            for (uint32_t c = 0; c < channels; ++c) {
+                fHistory[c][history] = io[c][i];
+                fHistory[c][history + kHistorySize] = io[c][i];
+                peak = std::max(peak, detectPeak(fHistory[c] + history + kHistorySize - kTruePeakTaps + 1));
+            }
+
+            // At unity with nothing to limit the gain path has nothing to do:
+            // every held, released and averaged gain is 1
+            const float required = peak > fCeiling ? fCeiling / peak : 1.0f;
+            float gain = 1.0f;
+            if (required < 1.0f || fUnityRun < fWindow) {
+                gain = limitGain(position, required);
+            } else {
+                fDequeGain[fDequeHead & kDequeMask] = 1.0f;
+                fDequePosition[fDequeHead & kDequeMask] = position;
+                fDequeTail = fDequeHead + 1;
+                fBoxSum = fWindow;
+                if (++fBoxIndex == fWindow) {
+                    fBoxIndex = 0;
+                }
+            }
+            lowestGain = std::min(lowestGain, gain);
+
+            const uint32_t write = position & kDelayMask;
+            const uint32_t read = (position - latency) & kDelayMask;
+            for (uint32_t c = 0; c < channels; ++c) {
+                fDelay[c][write] = io[c][i];
+                io[c][i] = fDelay[c][read] * gain;
+            }
+
+            fPosition = position + 1;
+        }
+
+        fGainReduction = lowestGain;
+    }
+
+private:
+    static constexpr uint32_t kHistorySize = 16;
+    static constexpr uint32_t kHistoryMask = kHistorySize - 1;
+    static constexpr uint32_t kDequeSize = 2048;
+    static constexpr uint32_t kDequeMask = kDequeSize - 1;
+    static constexpr uint32_t kDelaySize = 2048;
+    static constexpr uint32_t kDelayMask = kDelaySize - 1;
+    static constexpr uint32_t kPhases = 4;
+    static constexpr float kUnitySnap = 0.99999f;
+
+    // Windowed-sinc phases, shared by all limiters; bound is the largest
+    // gain any phase can have
+    struct Interpolator {
+        float phases[kPhases][kTruePeakTaps];
+        float bound;
+    };
+
+    // Gain for the sample the delay line releases now, from the gain
+    // required by the newest detected sample
+    float limitGain(uint32_t position, float required) {
+        // Hold the lowest required gain of the window (monotonic deque)
+        while (fDequeTail != fDequeHead &&
+               fDequeGain[(fDequeTail - 1) & kDequeMask] >= required) {
+            --fDequeTail;
+        }
+        fDequeGain[fDequeTail & kDequeMask] = required;
+        fDequePosition[fDequeTail & kDequeMask] = position;
+        ++fDequeTail;
+        if (position - fDequePosition[fDequeHead & kDequeMask] >= fWindow) {
+            ++fDequeHead;
+        }
+        const float held = fDequeGain[fDequeHead & kDequeMask];
+
+        // Release slowly, attack at once; snap to unity where the one-pole
+        // would stall a rounding step below it
+        float released = fReleased + (1.0f - fReleased) * fReleaseCoeff;
+        if (released >= kUnitySnap) {
+            released = 1.0f;
+        }
+        fReleased = std::min(held, released);
+        fUnityRun = fReleased == 1.0f ? fUnityRun + 1 : 0;
+
+        // Box filter: a linear ramp into every hold
+        fBoxSum += static_cast<double>(fReleased) - fBox[fBoxIndex];
+        fBox[fBoxIndex] = fReleased;
+        if (++fBoxIndex == fWindow) {
+            fBoxIndex = 0;
+            resyncBoxSum();
+        }
+        return static_cast<float>(fBoxSum * fInvWindow);
+    }
+
+    // x points at the oldest of kTruePeakTaps samples; the detected sample
+    // is x[kTruePeakTaps - 1 - kTruePeakDelay]
+    float detectPeak(const float* x) const {
+        const float sample = std::fabs(x[kTruePeakTaps - 1 - kTruePeakDelay]);
+        if (!fTruePeak) {
+            return sample;
+        }
+
+        // No interpolated value can reach the ceiling: the exact peak only
+        // matters above it
+        float window = 0.0f;
+        for (uint32_t j = 0; j < kTruePeakTaps; ++j) {
+            window = std::max(window, std::fabs(x[j]));
+        }
+        const Interpolator& interpolator = *fInterpolator;
+        if (window * interpolator.bound <= fCeiling) {
+            return sample;
+        }
+
+        float peak = sample;
+        for (uint32_t phase = 1; phase < kPhases; ++phase) {
+            float sum = 0.0f;
+            for (uint32_t j = 0; j < kTruePeakTaps; ++j) {
+                sum += interpolator.phases[phase][j] * x[j];
+            }
+            peak = std::max(peak, std::fabs(sum));
+        }
+        return peak;
+    }
+
+    // Windowed-sinc fractional delays at 1/4, 2/4 and 3/4 of a sample
+    // past the detected one, each normalised for unity DC gain
+    static void designInterpolator(Interpolator& interpolator) {
+        const double pi = 3.14159265358979323846;
+        const double half = kTruePeakTaps / 2.0;
+        interpolator.bound = 1.0f;
+
+        for (uint32_t phase = 0; phase < kPhases; ++phase) {
+            const double fraction = static_cast<double>(phase) / kPhases;
+            double sum = 0.0;
+            double taps[kTruePeakTaps];
+            for (uint32_t j = 0; j < kTruePeakTaps; ++j) {
+                const double t = static_cast<double>(j) - (kTruePeakTaps - 1 - kTruePeakDelay) - fraction;
+                const double sinc = std::fabs(t) < 1.0e-9 ? 1.0 : std::sin(pi * t) / (pi * t);
+                const double u = t / half;
+                const double window = std::fabs(u) >= 1.0 ? 0.0 : 0.5 + 0.5 * std::cos(pi * u);
+                taps[j] = sinc * window;
+                sum += taps[j];
+            }
+            float bound = 0.0f;
+            for (uint32_t j = 0; j < kTruePeakTaps; ++j) {
+                interpolator.phases[phase][j] = static_cast<float>(taps[j] / sum);
+                bound += std::fabs(interpolator.phases[phase][j]);
+            }
+            interpolator.bound = std::max(interpolator.bound, bound);
+        }
+    }
+
+    // The running sum is exact again once per window
+    void resyncBoxSum() {
+        double sum = 0.0;
+        for (uint32_t j = 0; j < fWindow; ++j) {
+            sum += fBox[j];
+        }
+        fBoxSum = sum;
+    }
+
+    float fCeiling;
+    bool fTruePeak;
+
+    uint32_t fLookahead;
+    uint32_t fWindow;
+    double fInvWindow;
+    float fReleaseCoeff;
+
+    // Sample counter (wraps; only differences are used)
+    uint32_t fPosition;
+
+    // Input history, stored twice so the taps are always contiguous
+    float fHistory[kMaxChannels][2 * kHistorySize];
+    std::shared_ptr<const Interpolator> fInterpolator;
+
+    // Sliding minimum of the required gain
+    float fDequeGain[kDequeSize];
+    uint32_t fDequePosition[kDequeSize];
+    uint32_t fDequeHead;
+    uint32_t fDequeTail;
+
+    float fReleased;
+
+    // Consecutive samples released at unity; a full window means the
+    // deque and the box hold nothing but 1
+    uint32_t fUnityRun;
+
+    // Attack ramp
+    float fBox[kMaxLookahead + 1];
+    uint32_t fBoxIndex;
+    double fBoxSum;
+
+    float fDelay[kMaxChannels][kDelaySize];
+
+    float fGainReduction;
+
+    LookaheadLimiter(const LookaheadLimiter&) = delete;
+    LookaheadLimiter& operator=(const LookaheadLimiter&) = delete;
+};
+
+} // namespace enlil
+
+#endif // LIMITER_HPP
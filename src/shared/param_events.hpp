@@ -0,0 +1,193 @@
+/*
+ * Parameter Events - Frame-stamped automation points for one audio block
+ * Part of the Enlil/GodotVST Framework
+ *
+ * The plugin collects the parameter changes for the next block as
+ * (frame, index, value) points, kept sorted by frame, and splits run() at
+ * them with ParameterSplitter: each sub-block ramps linearly to the values
+ * of the point that ends it, with coefficients computed once per
+ * sub-block. Changes without an offset are queued at kEndOfBlock, so they
+ * ramp across the whole block instead of stepping.
+ *
+ * Fixed capacity, no allocation. When full, a point replaces the last
+ * queued point of the same parameter (at the later of the two frames), so
+ * the value a block ends on is never lost.
+ *
+ * Audio thread only: the owner keeps changes made on other threads in
+ * atomics and queues them from run().
+ */
+
+#ifndef PARAM_EVENTS_HPP
+#define PARAM_EVENTS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace enlil {
+
+struct ParameterEvent {
+    uint32_t frame;
+    uint32_t index;
+    float value;
+};
+
+template <size_t Capacity>
+class ParameterEventQueue {
+public:
+    // Frame of changes that have no offset; clamped to the block length
+    static constexpr uint32_t kEndOfBlock = 0xFFFFFFFFu;
+
+    ParameterEventQueue() : fCount(0) {}
+
+    // Insert after every point at the same or an earlier frame, so points
+    // at one frame keep their order. Returns false if the point was merged
+    // into an earlier one or dropped.
+    bool push(uint32_t frame, uint32_t index, float value) {
+        if (fCount == Capacity) {
+            for (size_t i = fCount; i-- > 0;) {
+                if (fEvents[i].index == index) {
+                    ParameterEvent merged = fEvents[i];
+                    merged.frame = frame > merged.frame ? frame : merged.frame;
+                    merged.value = value;
+                    erase(i);
+                    insert(merged);
+                    return false;
+                }
+            }
+            return false;
+        }
+
+        ParameterEvent event;
+        event.frame = frame;
+        event.index = index;
+        event.value = value;
+        insert(event);
+        return true;
+    }
+
+    size_t size() const { return fCount; }
+    bool empty() const { return fCount == 0; }
+    const ParameterEvent& operator[](size_t i) const { return fEvents[i]; }
+
+    void clear() { fCount = 0; }
+
+private:
+    void insert(const ParameterEvent& event) {
+        size_t position = fCount;
+        while (position > 0 && fEvents[position - 1].frame > event.frame) {
+            fEvents[position] = fEvents[position - 1];
+            --position;
+        }
+        fEvents[position] = event;
+        ++fCount;
+    }
+
+    void erase(size_t i) {
+        for (; i + 1 < fCount; ++i) {
+            fEvents[i] = fEvents[i + 1];
+        }
+        --fCount;
+    }
+
+    ParameterEvent fEvents[Capacity];
+    size_t fCount;
+};
+
+// Walks one block split at the queued points. Each parameter is piecewise
+// linear between its own points, starting from its value at the block
+// start; next() yields the sub-blocks in order and getValue() every
+// parameter's value at the end of the current one, which is exact at a
+// point. Points address parameters by index (below Parameters, others are
+// ignored); points past the block land on its end.
+template <size_t Capacity, uint32_t Parameters>
+class ParameterSplitter {
+public:
+    ParameterSplitter(const ParameterEventQueue<Capacity>& events, uint32_t frames,
+                      const float (&values)[Parameters])
+        : fEvents(events),
+          fFrames(frames),
+          fStart(0),
+          fEvent(0)
+    {
+        for (uint32_t p = 0; p < Parameters; ++p) {
+            fValue[p] = fFromValue[p] = values[p];
+            fFromFrame[p] = 0;
+        }
+    }
+
+    // The next non-empty sub-block [start, end); false once the block is
+    // done. An empty block still lands on its points.
+    bool next(uint32_t& start, uint32_t& end) {
+        while (fStart < fFrames) {
+            const uint32_t to = fEvent < fEvents.size() ? frameOf(fEvents[fEvent]) : fFrames;
+
+            // Parameters with a point here take its value...
+            bool atPoint[Parameters] = {};
+            for (; fEvent < fEvents.size() && frameOf(fEvents[fEvent]) == to; ++fEvent) {
+                const ParameterEvent& event = fEvents[fEvent];
+                if (event.index < Parameters) {
+                    fValue[event.index] = fFromValue[event.index] = event.value;
+                    fFromFrame[event.index] = to;
+                    atPoint[event.index] = true;
+                }
+            }
+
+            // ...the others are interpolated toward their next point, if any
+            // (the last of several at one frame)
+            for (uint32_t p = 0; p < Parameters; ++p) {
+                size_t target = fEvents.size();
+                for (size_t next = fEvent; !atPoint[p] && next < fEvents.size(); ++next) {
+                    if (fEvents[next].index != p) {
+                        continue;
+                    }
+                    if (target != fEvents.size() && frameOf(fEvents[next]) != frameOf(fEvents[target])) {
+                        break;
+                    }
+                    target = next;
+                }
+                if (target != fEvents.size()) {
+                    const uint32_t frame = frameOf(fEvents[target]);
+                    fValue[p] = fFromValue[p] + (fEvents[target].value - fFromValue[p]) *
+                                                (to - fFromFrame[p]) / (frame - fFromFrame[p]);
+                }
+            }
+
+            if (to == fStart) {
+                continue;
+            }
+            start = fStart;
+            end = to;
+            fStart = to;
+            return true;
+        }
+
+        for (; fEvent < fEvents.size(); ++fEvent) {
+            if (fEvents[fEvent].index < Parameters) {
+                fValue[fEvents[fEvent].index] = fEvents[fEvent].value;
+            }
+        }
+        return false;
+    }
+
+    float getValue(uint32_t p) const { return fValue[p]; }
+
+private:
+    uint32_t frameOf(const ParameterEvent& event) const {
+        return event.frame < fFrames ? event.frame : fFrames;
+    }
+
+    const ParameterEventQueue<Capacity>& fEvents;
+    const uint32_t fFrames;
+    uint32_t fStart;
+    size_t fEvent;
+
+    // Per parameter: value at the current sub-block's end, and the last
+    // point passed (the start of the block until there is one)
+    float fValue[Parameters];
+    float fFromValue[Parameters];
+    uint32_t fFromFrame[Parameters];
+};
+
+} // namespace enlil
+
+#endif // PARAM_EVENTS_HPP
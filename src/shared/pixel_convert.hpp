@@ -0,0 +1,183 @@
+/*
+ * Pixel Conversion - SIMD helpers for writing frames into FrameBridge slots
+ * Part of the Enlil/GodotVST Framework
+ *
+ * All routines convert straight from the source image into the destination
+ * frame slot in a single pass. RGBA and BGRA share the alpha byte position,
+ * so premultiply/opaque work for both orders.
+ *
+ * x86-64: SSE2 is always available; the RGB expansion uses SSSE3 when the
+ * CPU supports it (runtime dispatch, no build flag needed).
+ * ARM: NEON paths when __ARM_NEON is defined.
+ */
+
+#ifndef PIXEL_CONVERT_HPP
+#define PIXEL_CONVERT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__)
+#define ENLIL_PIXEL_SSE2 1
+#include <emmintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define ENLIL_PIXEL_SSSE3 1
+#include <tmmintrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define ENLIL_PIXEL_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace enlil {
+namespace pixel {
+
+// Exact x * a / 255 with rounding, for 8-bit operands
+inline uint8_t mulDiv255(uint32_t x, uint32_t a) {
+    uint32_t t = x * a + 128;
+    return static_cast<uint8_t>((t + (t >> 8)) >> 8);
+}
+
+// Plain 4-byte-per-pixel copy (RGBA → RGBA, BGRA → BGRA)
+inline void copy32(const uint8_t* src, uint8_t* dst, size_t pixels) {
+    std::memcpy(dst, src, pixels * 4);
+}
+
+// Copy 4-byte pixels, multiplying colour channels by alpha
+inline void premultiply32(const uint8_t* src, uint8_t* dst, size_t pixels) {
+    size_t i = 0;
+
+#if defined(ENLIL_PIXEL_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i round = _mm_set1_epi16(128);
+    // Alpha lanes are multiplied by 255 so they come out unchanged
+    const __m128i alphaLane = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+    const __m128i alphaOne = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+
+    for (; i + 4 <= pixels; i += 4) {
+        const __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+        __m128i lo = _mm_unpacklo_epi8(px, zero);
+        __m128i hi = _mm_unpackhi_epi8(px, zero);
+
+        __m128i alo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, 0xFF), 0xFF);
+        __m128i ahi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, 0xFF), 0xFF);
+        alo = _mm_or_si128(_mm_andnot_si128(alphaLane, alo), alphaOne);
+        ahi = _mm_or_si128(_mm_andnot_si128(alphaLane, ahi), alphaOne);
+
+        lo = _mm_add_epi16(_mm_mullo_epi16(lo, alo), round);
+        hi = _mm_add_epi16(_mm_mullo_epi16(hi, ahi), round);
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_packus_epi16(lo, hi));
+    }
+#elif defined(ENLIL_PIXEL_NEON)
+    for (; i + 8 <= pixels; i += 8) {
+        uint8x8x4_t px = vld4_u8(src + i * 4);
+        const uint8x8_t a = px.val[3];
+        for (int c = 0; c < 3; ++c) {
+            uint16x8_t t = vmull_u8(px.val[c], a);
+            // (t + 128 + ((t + 128) >> 8)) >> 8
+            px.val[c] = vraddhn_u16(t, vrshrq_n_u16(t, 8));
+        }
+        vst4_u8(dst + i * 4, px);
+    }
+#endif
+
+    for (; i < pixels; ++i) {
+        const uint8_t* s = src + i * 4;
+        uint8_t* d = dst + i * 4;
+        const uint32_t a = s[3];
+        d[0] = mulDiv255(s[0], a);
+        d[1] = mulDiv255(s[1], a);
+        d[2] = mulDiv255(s[2], a);
+        d[3] = s[3];
+    }
+}
+
+// Copy 4-byte pixels, forcing alpha to 255 (opaque UIs)
+inline void dropAlpha32(const uint8_t* src, uint8_t* dst, size_t pixels) {
+    size_t i = 0;
+
+#if defined(ENLIL_PIXEL_SSE2)
+    const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+    for (; i + 4 <= pixels; i += 4) {
+        const __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_or_si128(px, alpha));
+    }
+#elif defined(ENLIL_PIXEL_NEON)
+    const uint8x16_t alpha = vreinterpretq_u8_u32(vdupq_n_u32(0xFF000000u));
+    for (; i + 4 <= pixels; i += 4) {
+        vst1q_u8(dst + i * 4, vorrq_u8(vld1q_u8(src + i * 4), alpha));
+    }
+#endif
+
+    for (; i < pixels; ++i) {
+        std::memcpy(dst + i * 4, src + i * 4, 3);
+        dst[i * 4 + 3] = 255;
+    }
+}
+
+#if defined(ENLIL_PIXEL_SSSE3)
+// 16 pixels (48 source bytes) per iteration
+__attribute__((target("ssse3")))
+inline size_t expandRGB24Ssse3(const uint8_t* src, uint8_t* dst, size_t pixels) {
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+    size_t i = 0;
+
+    for (; i + 16 <= pixels; i += 16) {
+        const uint8_t* s = src + i * 3;
+        __m128i* d = reinterpret_cast<__m128i*>(dst + i * 4);
+        const __m128i in0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+        const __m128i in1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 16));
+        const __m128i in2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 32));
+
+        _mm_storeu_si128(d + 0, _mm_or_si128(_mm_shuffle_epi8(in0, shuffle), alpha));
+        _mm_storeu_si128(d + 1, _mm_or_si128(_mm_shuffle_epi8(_mm_alignr_epi8(in1, in0, 12), shuffle), alpha));
+        _mm_storeu_si128(d + 2, _mm_or_si128(_mm_shuffle_epi8(_mm_alignr_epi8(in2, in1, 8), shuffle), alpha));
+        _mm_storeu_si128(d + 3, _mm_or_si128(_mm_shuffle_epi8(_mm_srli_si128(in2, 4), shuffle), alpha));
+    }
+
+    return i;
+}
+
+inline bool cpuHasSsse3() {
+    static const bool has = __builtin_cpu_supports("ssse3");
+    return has;
+}
+#endif
+
+// Expand 3-byte pixels to 4-byte pixels with alpha = 255 (RGB8 → RGBA8)
+inline void expandRGB24(const uint8_t* src, uint8_t* dst, size_t pixels) {
+    size_t i = 0;
+
+#if defined(ENLIL_PIXEL_SSSE3)
+    if (cpuHasSsse3()) {
+        i = expandRGB24Ssse3(src, dst, pixels);
+    }
+#elif defined(ENLIL_PIXEL_NEON)
+    for (; i + 16 <= pixels; i += 16) {
+        const uint8x16x3_t in = vld3q_u8(src + i * 3);
+        uint8x16x4_t out;
+        out.val[0] = in.val[0];
+        out.val[1] = in.val[1];
+        out.val[2] = in.val[2];
+        out.val[3] = vdupq_n_u8(255);
+        vst4q_u8(dst + i * 4, out);
+    }
+#endif
+
+    for (; i < pixels; ++i) {
+        dst[i * 4 + 0] = src[i * 3 + 0];
+        dst[i * 4 + 1] = src[i * 3 + 1];
+        dst[i * 4 + 2] = src[i * 3 + 2];
+        dst[i * 4 + 3] = 255;
+    }
+}
+
+} // namespace pixel
+} // namespace enlil
+
+#endif // PIXEL_CONVERT_HPP
@@ -0,0 +1,519 @@
+/*
+ * Saturator - FatSat's tanh waveshaper with CPU/fidelity quality tiers
+ * Part of the Enlil/GodotVST Framework
+ *
+ * Three tiers trade CPU for fidelity:
+ * - Eco:    rational tanh approximation, no anti-aliasing, drive and gain
+ *           held at their end value per process() call
+ * - Normal: exact tanh with first-order antiderivative anti-aliasing
+ *           (ADAA), drive and gain ramped per sample
+ * - HQ:     exact tanh at 2x oversampling (31-tap halfband FIR up and
+ *           down), drive and gain ramped per sample
+ *
+ * Each process() call ramps drive and gain linearly from where the last
+ * call ended to the values it is given, so a caller that splits a block at
+ * automation points gets piecewise-linear automation.
+ *
+ * The oversampler's linear-phase filters delay the signal by kLatency
+ * samples; Eco and Normal read their input kLatency samples late, so every
+ * tier has the same latency and the plugin reports it once.
+ *
+ * Tier changes take effect at the next block: the new tier's state is
+ * rebuilt from the input history and its output is crossfaded with the
+ * old tier's over kCrossfadeFrames, so switching never clicks. Nothing
+ * allocates after construction; run() may be called with any block size.
+ * The halfband taps are built once per process and shared through the
+ * DSPTableCache.
+ *
+ * A drawn curve (CurveTable) can replace tanh in every tier: Eco and HQ
+ * look it up, Normal uses its tabulated antiderivative.
+ *
+ * DSPTierSelector picks a tier from the measured per-block load ("Auto").
+ *
+ * Audio thread only, except for construction.
+ */
+
+#ifndef SATURATOR_HPP
+#define SATURATOR_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#include "curve_table.hpp"
+#include "table_cache.hpp"
+
+namespace enlil {
+
+enum DSPTier {
+    DSP_TIER_ECO,
+    DSP_TIER_NORMAL,
+    DSP_TIER_HQ,
+    DSP_TIER_COUNT
+};
+
+inline const char* dspTierName(DSPTier tier) {
+    switch (tier) {
+    case DSP_TIER_ECO:    return "Eco";
+    case DSP_TIER_NORMAL: return "Normal";
+    case DSP_TIER_HQ:     return "HQ";
+    default:              return "unknown";
+    }
+}
+
+class Saturator {
+public:
+    // Halfband filter length; the up/down pair delays by (kTaps - 1) / 2
+    // base-rate samples
+    static constexpr uint32_t kTaps = 31;
+    static constexpr uint32_t kLatency = (kTaps - 1) / 2;
+
+    // Length of the crossfade after a tier change
+    static constexpr uint32_t kCrossfadeFrames = 256;
+
+    Saturator()
+        : fTier(DSP_TIER_NORMAL),
+          fFadeTier(DSP_TIER_NORMAL),
+          fFadeRemaining(0),
+          fDrive(1.0f),
+          fGain(1.0f),
+          fCurve(nullptr),
+          fAdaaPrevious(0.0)
+    {
+        const DSPTableKey key = {DSP_TABLE_HALFBAND, 2, kTaps, 0.0, 0};
+        fHalfband = DSPTableCache::instance().acquire<HalfbandTaps>(key, designHalfband);
+        fEvenTaps = fHalfband->taps;
+        reset(1.0f, 1.0f);
+    }
+
+    // Clear all history and the curve; the next process() call ramps from
+    // drive and gain
+    void reset(float drive, float gain) {
+        std::memset(fInput, 0, sizeof(fInput));
+        std::memset(fOversampledEven, 0, sizeof(fOversampledEven));
+        std::memset(fOversampledOdd, 0, sizeof(fOversampledOdd));
+        fDrive = drive;
+        fGain = gain;
+        fAdaaPrevious = 0.0;
+        fFadeRemaining = 0;
+        fCurve = nullptr;
+    }
+
+    // Takes effect at the next process() call, crossfaded. Call once per
+    // block: a change requested during a crossfade waits for it to finish.
+    void setTier(DSPTier tier) {
+        if (tier == fTier || static_cast<int>(tier) < 0 || tier >= DSP_TIER_COUNT ||
+            fFadeRemaining > 0) {
+            return;
+        }
+        primeTier(tier);
+        fFadeTier = fTier;
+        fFadeRemaining = kCrossfadeFrames;
+        fTier = tier;
+    }
+
+    DSPTier getTier() const { return fTier; }
+
+    // Shape with a drawn curve instead of tanh (nullptr: tanh) from the
+    // next process() call, without a crossfade. The table must stay valid
+    // until it is replaced or reset() clears it; setTier() evaluates it, so
+    // set the block's curve first.
+    void setCurve(const CurveTable* curve) { fCurve = curve; }
+
+    // Shape frames samples; drive (input gain into tanh) and output gain
+    // ramp linearly to the given values, reached on the last sample. Eco
+    // holds the end values instead, so both follow the same trajectory at
+    // call boundaries.
+    void process(const float* in, float* out, uint32_t frames, float drive, float gain) {
+        if (frames == 0) {
+            return;
+        }
+
+        const float driveStart = fDrive;
+        const float gainStart = fGain;
+        const float driveStep = (drive - driveStart) / frames;
+        const float gainStep = (gain - gainStart) / frames;
+        fDrive = drive;
+        fGain = gain;
+
+        for (uint32_t offset = 0; offset < frames; offset += kChunk) {
+            const uint32_t count = std::min(kChunk, frames - offset);
+            std::memcpy(fInput + kHistory, in + offset, count * sizeof(float));
+
+            Ramp ramp;
+            ramp.drive = driveStart + driveStep * (offset + 1);
+            ramp.driveStep = driveStep;
+            ramp.gain = gainStart + gainStep * (offset + 1);
+            ramp.gainStep = gainStep;
+
+            processTier(fTier, ramp, out + offset, count);
+
+            if (fFadeRemaining > 0) {
+                processTier(fFadeTier, ramp, fScratch, count);
+
+                const uint32_t fadeCount = std::min(count, fFadeRemaining);
+                const float fadeStep = 1.0f / kCrossfadeFrames;
+                float fade = (kCrossfadeFrames - fFadeRemaining) * fadeStep;
+                for (uint32_t i = 0; i < fadeCount; ++i) {
+                    out[offset + i] = fScratch[i] + (out[offset + i] - fScratch[i]) * fade;
+                    fade += fadeStep;
+                }
+                fFadeRemaining -= fadeCount;
+            }
+
+            // Keep the tail as history for the next chunk
+            std::memmove(fInput, fInput + count, kHistory * sizeof(float));
+        }
+    }
+
+private:
+    // Input samples processed per pass, and how many past samples are kept
+    // in front of them (latency plus the upsampler's reach)
+    static constexpr uint32_t kChunk = 256;
+    static constexpr uint32_t kHalfTaps = (kTaps + 1) / 2;
+    static constexpr uint32_t kHistory = kLatency + kHalfTaps + 1;
+
+    // History the downsampler needs: kHalfTaps - 1 even samples, and the
+    // odd sample kHalfTaps / 2 base samples back
+    static constexpr uint32_t kEvenHistory = kHalfTaps - 1;
+    static constexpr uint32_t kOddHistory = kHalfTaps / 2;
+
+    struct Ramp {
+        float drive, driveStep;
+        float gain, gainStep;
+    };
+
+    // Non-zero halfband taps, shared by all saturators
+    struct HalfbandTaps {
+        float taps[kHalfTaps];
+    };
+
+    // The transfer function, chosen once per call: each tier is compiled
+    // for tanh and for a curve table
+    struct TanhShaper {
+        // Rational approximation, within 2.5% of tanh and exactly +-1
+        // beyond +-3
+        float fast(float x) const {
+            x = std::max(-3.0f, std::min(3.0f, x));
+            const float x2 = x * x;
+            return x * (27.0f + x2) / (27.0f + 9.0f * x2);
+        }
+
+        float operator()(float x) const { return std::tanh(x); }
+        double operator()(double x) const { return std::tanh(x); }
+
+        // log(cosh(x)) without overflow
+        double antiderivative(double x) const {
+            const double a = std::fabs(x);
+            return a + std::log1p(std::exp(-2.0 * a)) - 0.6931471805599453;
+        }
+    };
+
+    struct CurveShaper {
+        const CurveTable* table;
+
+        float fast(float x) const { return table->evaluate(x); }
+        float operator()(float x) const { return table->evaluate(x); }
+        double operator()(double x) const { return table->evaluate(x); }
+        double antiderivative(double x) const { return table->antiderivative(x); }
+    };
+
+    void processTier(DSPTier tier, const Ramp& ramp, float* out, uint32_t count) {
+        if (fCurve) {
+            processTier(tier, CurveShaper{fCurve}, ramp, out, count);
+        } else {
+            processTier(tier, TanhShaper(), ramp, out, count);
+        }
+    }
+
+    template<typename Shaper>
+    void processTier(DSPTier tier, const Shaper& shape, const Ramp& ramp, float* out, uint32_t count) {
+        switch (tier) {
+        case DSP_TIER_ECO:    processEco(shape, ramp, out, count); break;
+        case DSP_TIER_NORMAL: processNormal(shape, ramp, out, count); break;
+        default:              processHQ(shape, ramp, out, count); break;
+        }
+    }
+
+    template<typename Shaper>
+    void processEco(const Shaper& shape, const Ramp& ramp, float* out, uint32_t count) {
+        (void)ramp;
+
+        // Per-block parameters: the value the ramp ends on
+        const float drive = fDrive;
+        const float gain = fGain;
+        const float* x = fInput + kHistory - kLatency;
+
+        for (uint32_t i = 0; i < count; ++i) {
+            out[i] = shape.fast(x[i] * drive) * gain;
+        }
+    }
+
+    template<typename Shaper>
+    void processNormal(const Shaper& shape, const Ramp& ramp, float* out, uint32_t count) {
+        const float* x = fInput + kHistory - kLatency;
+        float drive = ramp.drive;
+        float gain = ramp.gain;
+        double previous = fAdaaPrevious;
+
+        for (uint32_t i = 0; i < count; ++i) {
+            const double current = static_cast<double>(x[i]) * drive;
+            const double delta = current - previous;
+            const double shaped = std::fabs(delta) > 1.0e-4
+                ? (shape.antiderivative(current) - shape.antiderivative(previous)) / delta
+                : shape(0.5 * (current + previous));
+            out[i] = static_cast<float>(shaped) * gain;
+
+            previous = current;
+            drive += ramp.driveStep;
+            gain += ramp.gainStep;
+        }
+
+        fAdaaPrevious = previous;
+    }
+
+    // Upsample base-rate sample n of fInput (index into the buffer) into
+    // the two 2x samples, without drive
+    void upsample(uint32_t n, float& even, float& odd) const {
+        float sum = 0.0f;
+        for (uint32_t j = 0; j < kHalfTaps; ++j) {
+            sum += fEvenTaps[j] * fInput[n - j];
+        }
+        even = 2.0f * sum;
+
+        // Odd 2x samples only see the centre tap: a plain delay
+        odd = fInput[n - kLatency / 2];
+    }
+
+    template<typename Shaper>
+    void processHQ(const Shaper& shape, const Ramp& ramp, float* out, uint32_t count) {
+        float* even = fOversampledEven + kEvenHistory;
+        float* odd = fOversampledOdd + kOddHistory;
+        float drive = ramp.drive;
+        float gain = ramp.gain;
+
+        for (uint32_t i = 0; i < count; ++i) {
+            float upEven, upOdd;
+            upsample(kHistory + i, upEven, upOdd);
+            even[i] = shape(upEven * drive);
+            odd[i] = shape(upOdd * drive);
+
+            // Decimate: even taps on the even phase, centre tap on the odd
+            float sum = 0.5f * odd[static_cast<int32_t>(i) - static_cast<int32_t>(kOddHistory)];
+            for (uint32_t j = 0; j < kHalfTaps; ++j) {
+                sum += fEvenTaps[j] * even[static_cast<int32_t>(i) - static_cast<int32_t>(j)];
+            }
+            out[i] = sum * gain;
+
+            drive += ramp.driveStep;
+            gain += ramp.gainStep;
+        }
+
+        std::memmove(fOversampledEven, fOversampledEven + count, kEvenHistory * sizeof(float));
+        std::memmove(fOversampledOdd, fOversampledOdd + count, kOddHistory * sizeof(float));
+    }
+
+    // Rebuild a tier's state from the input history before switching to it
+    void primeTier(DSPTier tier) {
+        if (fCurve) {
+            primeTier(tier, CurveShaper{fCurve});
+        } else {
+            primeTier(tier, TanhShaper());
+        }
+    }
+
+    template<typename Shaper>
+    void primeTier(DSPTier tier, const Shaper& shape) {
+        const float drive = fDrive;
+
+        if (tier == DSP_TIER_NORMAL) {
+            fAdaaPrevious = static_cast<double>(fInput[kHistory - kLatency - 1]) * drive;
+        } else if (tier == DSP_TIER_HQ) {
+            for (uint32_t k = 0; k < kEvenHistory; ++k) {
+                float upEven, upOdd;
+                upsample(kHistory - kEvenHistory + k, upEven, upOdd);
+                fOversampledEven[k] = shape(upEven * drive);
+                if (k >= kEvenHistory - kOddHistory) {
+                    fOversampledOdd[k - (kEvenHistory - kOddHistory)] = shape(upOdd * drive);
+                }
+            }
+        }
+    }
+
+    // Blackman-windowed sinc halfband, normalised for unity DC gain; only
+    // the taps at odd distances from the centre (plus the centre, 0.5)
+    // are non-zero, taps[j] is tap 2j
+    static void designHalfband(HalfbandTaps& halfband) {
+        float* taps = halfband.taps;
+        const double pi = 3.14159265358979323846;
+        const int32_t centre = static_cast<int32_t>(kTaps - 1) / 2;
+        double sum = 0.0;
+
+        for (uint32_t j = 0; j < kHalfTaps; ++j) {
+            const int32_t k = static_cast<int32_t>(2 * j);
+            const double t = (k - centre) * 0.5;
+            const double sinc = std::sin(pi * t) / (pi * t);
+            const double window = 0.42 - 0.5 * std::cos(2.0 * pi * k / (kTaps - 1)) +
+                                  0.08 * std::cos(4.0 * pi * k / (kTaps - 1));
+            taps[j] = static_cast<float>(0.5 * sinc * window);
+            sum += taps[j];
+        }
+
+        for (uint32_t j = 0; j < kHalfTaps; ++j) {
+            taps[j] = static_cast<float>(taps[j] * 0.5 / sum);
+        }
+    }
+
+    DSPTier fTier;
+
+    // Tier being faded out after a switch
+    DSPTier fFadeTier;
+    uint32_t fFadeRemaining;
+
+    // Drive and gain at the end of the last call
+    float fDrive, fGain;
+
+    // Drawn curve in use, or nullptr for tanh
+    const CurveTable* fCurve;
+
+    // Input history followed by the current chunk
+    float fInput[kHistory + kChunk];
+
+    // Normal: previous driven input
+    double fAdaaPrevious;
+
+    // HQ: halfband taps (owned by the cache entry), and saturated 2x
+    // samples (history followed by the current chunk)
+    std::shared_ptr<const HalfbandTaps> fHalfband;
+    const float* fEvenTaps;
+    float fOversampledEven[kEvenHistory + kChunk];
+    float fOversampledOdd[kOddHistory + kChunk];
+
+    // Output of the tier being faded out
+    float fScratch[kChunk];
+
+    Saturator(const Saturator&) = delete;
+    Saturator& operator=(const Saturator&) = delete;
+};
+
+// Chooses the tier for "Auto" from the per-block load of run(). Steps
+// down at once when the smoothed load passes kDowngradeLoad or a deadline
+// is missed; steps up only after the next tier's predicted load has stayed
+// under kUpgradeLoad for kUpgradeHoldSeconds. Predictions use each tier's
+// cost relative to the one below, learned from the load on either side of
+// earlier switches.
+class DSPTierSelector {
+public:
+    static constexpr double kDowngradeLoad = 0.7;
+    static constexpr double kUpgradeLoad = 0.45;
+    static constexpr double kUpgradeHoldSeconds = 3.0;
+
+    // Smoothing of the block load, and how long a new tier runs before
+    // its load is trusted
+    static constexpr double kSmoothingSeconds = 0.1;
+    static constexpr double kSettleSeconds = 0.25;
+
+    // Cost of a tier relative to the one below until it has been measured
+    static constexpr double kDefaultCostRatio = 2.5;
+
+    DSPTierSelector()
+        : fTier(DSP_TIER_NORMAL),
+          fSwitchedFrom(DSP_TIER_NORMAL),
+          fLoad(0.0),
+          fLoadBeforeSwitch(0.0),
+          fCalmSeconds(0.0),
+          fSettleSeconds(0.0)
+    {
+        std::fill(fCostRatio, fCostRatio + DSP_TIER_COUNT, kDefaultCostRatio);
+    }
+
+    // Start over from the given tier (learned costs are kept)
+    void reset(DSPTier tier) {
+        fTier = tier;
+        fSwitchedFrom = tier;
+        fLoad = 0.0;
+        fCalmSeconds = 0.0;
+        fSettleSeconds = kSettleSeconds;
+    }
+
+    // Account a block; load is busy time over the block's budget and
+    // overrun is true if any meter in the process missed its deadline
+    DSPTier update(double load, bool overrun, uint32_t frames, double sampleRate) {
+        if (frames == 0 || sampleRate <= 0.0) {
+            return fTier;
+        }
+
+        const double seconds = frames / sampleRate;
+        const double coeff = std::exp(-seconds / kSmoothingSeconds);
+        fLoad = load + (fLoad - load) * coeff;
+
+        if (fSettleSeconds > 0.0) {
+            fSettleSeconds -= seconds;
+            if (fSettleSeconds <= 0.0) {
+                learnCost();
+            }
+            if (!overrun) {
+                return fTier;
+            }
+        }
+
+        if ((overrun || fLoad > kDowngradeLoad) && fTier > DSP_TIER_ECO) {
+            switchTo(static_cast<DSPTier>(fTier - 1));
+            return fTier;
+        }
+
+        if (fTier == DSP_TIER_HQ) {
+            return fTier;
+        }
+
+        const DSPTier next = static_cast<DSPTier>(fTier + 1);
+        if (fLoad * fCostRatio[next] < kUpgradeLoad) {
+            fCalmSeconds += seconds;
+            if (fCalmSeconds >= kUpgradeHoldSeconds) {
+                switchTo(next);
+            }
+        } else {
+            fCalmSeconds = 0.0;
+        }
+        return fTier;
+    }
+
+    DSPTier getTier() const { return fTier; }
+
+private:
+    void switchTo(DSPTier tier) {
+        fSwitchedFrom = fTier;
+        fLoadBeforeSwitch = fLoad;
+        fTier = tier;
+        fCalmSeconds = 0.0;
+        fSettleSeconds = kSettleSeconds;
+    }
+
+    // Compare the settled load with the load before the last switch
+    void learnCost() {
+        if (fSwitchedFrom == fTier || fLoad < 1.0e-3 || fLoadBeforeSwitch < 1.0e-3) {
+            return;
+        }
+        const DSPTier upper = std::max(fTier, fSwitchedFrom);
+        const double ratio = fTier > fSwitchedFrom ? fLoad / fLoadBeforeSwitch
+                                                   : fLoadBeforeSwitch / fLoad;
+        fCostRatio[upper] = std::max(1.0, std::min(8.0, ratio));
+        fSwitchedFrom = fTier;
+    }
+
+    DSPTier fTier;
+    DSPTier fSwitchedFrom;
+    double fLoad;
+    double fLoadBeforeSwitch;
+    double fCalmSeconds;
+    double fSettleSeconds;
+
+    // Load of each tier over the one below (index 0 unused)
+    double fCostRatio[DSP_TIER_COUNT];
+};
+
+} // namespace enlil
+
+#endif // SATURATOR_HPP
@@ -0,0 +1,418 @@
+/*
+ * Session Log - Record and replay of a plugin session for perf regressions
+ * Part of the Enlil/GodotVST Framework
+ *
+ * Records everything that drives the plugin, with host timestamps, into a
+ * compact binary log: the FrameBridge input stream, resize requests,
+ * parameter changes and the audio fed to run(). A replayer
+ * (src/plugin/tools/FatSatReplay.cpp) feeds the log back into the DSP and
+ * the Godot UI headlessly, so a recorded interaction becomes a repeatable
+ * benchmark.
+ *
+ * Recording is enabled by setting FATSAT_RECORD_SESSION to an output path
+ * before the plugin loads. With several plugin instances in one process,
+ * the first DSP and the first editor to claim() the recorder are recorded.
+ *
+ * Records are appended to a memory buffer under a mutex; the audio thread
+ * only ever try-locks it and drops the record if the lock is taken or the
+ * buffer is full (the drop count is reported when the log is closed). A
+ * writer thread moves the buffer to disk every kFlushIntervalMs.
+ *
+ * File layout (little endian, packed):
+ *   SessionFileHeader
+ *   { SessionRecordHeader, payload[size] }*
+ * Records are in timestamp order: the timestamp is taken under the lock.
+ */
+
+#ifndef SESSION_LOG_HPP
+#define SESSION_LOG_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "frame_bridge.hpp"
+
+namespace enlil {
+
+static constexpr uint32_t kSessionMagic = 0x474C5346; // "FSLG"
+static constexpr uint32_t kSessionVersion = 1;
+
+enum SessionRecordType : uint8_t {
+    SESSION_INPUT = 1,     // SessionInput
+    SESSION_RESIZE = 2,    // SessionResize
+    SESSION_PARAMETER = 3, // SessionParameter
+    SESSION_AUDIO = 4      // SessionAudio + channels * frames float, planar
+};
+
+enum SessionSource {
+    SESSION_SOURCE_DSP,
+    SESSION_SOURCE_EDITOR,
+    SESSION_SOURCE_COUNT
+};
+
+#pragma pack(push, 1)
+
+struct SessionFileHeader {
+    uint32_t magic;
+    uint32_t version;
+};
+
+struct SessionRecordHeader {
+    uint64_t timeNs;   // Since the recorder was created
+    uint32_t size;     // Payload bytes following this header
+    uint8_t type;      // SessionRecordType
+    uint8_t reserved[3];
+};
+
+struct SessionInput {
+    uint8_t type;      // InputEvent::Type
+    uint8_t pressed;
+    uint16_t reserved;
+    int32_t button;
+    float x;
+    float y;
+    float scrollX;
+    float scrollY;
+};
+
+struct SessionResize {
+    int32_t width;
+    int32_t height;
+};
+
+struct SessionParameter {
+    uint32_t index;
+    float value;
+};
+
+struct SessionAudio {
+    double sampleRate;
+    uint32_t frames;
+    uint32_t channels;
+};
+
+#pragma pack(pop)
+
+inline SessionInput toSessionInput(const InputEvent& event) {
+    SessionInput input;
+    input.type = static_cast<uint8_t>(event.type);
+    input.pressed = event.pressed ? 1 : 0;
+    input.reserved = 0;
+    input.button = event.button;
+    input.x = event.x;
+    input.y = event.y;
+    input.scrollX = event.scrollX;
+    input.scrollY = event.scrollY;
+    return input;
+}
+
+inline InputEvent fromSessionInput(const SessionInput& input, uint64_t timestamp) {
+    InputEvent event;
+    event.type = static_cast<InputEvent::Type>(input.type);
+    event.x = input.x;
+    event.y = input.y;
+    event.button = input.button;
+    event.pressed = input.pressed != 0;
+    event.scrollX = input.scrollX;
+    event.scrollY = input.scrollY;
+    event.timestamp = timestamp;
+    return event;
+}
+
+class SessionRecorder {
+public:
+    // Buffered between two flushes; ~20 s of stereo audio at 48 kHz
+    static constexpr size_t kBufferBytes = 8u << 20;
+    static constexpr uint32_t kFlushIntervalMs = 50;
+    static constexpr uint32_t kMaxChannels = 8;
+
+    static SessionRecorder& instance() {
+        static SessionRecorder inst;
+        return inst;
+    }
+
+    bool isRecording() const { return fFile != nullptr; }
+
+    // Become the recorded DSP / editor; false if recording is off or
+    // another instance already is
+    bool claim(SessionSource source, const void* owner) {
+        if (!isRecording()) {
+            return false;
+        }
+        const void* expected = nullptr;
+        return fOwners[source].compare_exchange_strong(expected, owner) || expected == owner;
+    }
+
+    void unclaim(SessionSource source, const void* owner) {
+        const void* expected = owner;
+        fOwners[source].compare_exchange_strong(expected, nullptr);
+    }
+
+    // === DPF UI thread ===
+
+    void recordInput(const InputEvent& event) {
+        const SessionInput input = toSessionInput(event);
+        const Chunk chunk = { &input, sizeof(input) };
+        append(SESSION_INPUT, &chunk, 1, false);
+    }
+
+    void recordResize(int width, int height) {
+        const SessionResize resize = { width, height };
+        const Chunk chunk = { &resize, sizeof(resize) };
+        append(SESSION_RESIZE, &chunk, 1, false);
+    }
+
+    // Adapter for FrameBridge::setInputObserver()
+    static void inputObserver(void* context, const InputEvent& event) {
+        static_cast<SessionRecorder*>(context)->recordInput(event);
+    }
+
+    // === Any thread, RT-safe ===
+
+    // Hosts call setParameterValue() from the audio thread too
+    void recordParameter(uint32_t index, float value) {
+        const SessionParameter parameter = { index, value };
+        const Chunk chunk = { &parameter, sizeof(parameter) };
+        append(SESSION_PARAMETER, &chunk, 1, true);
+    }
+
+    void recordAudio(const float* const* inputs, uint32_t channels, uint32_t frames, double sampleRate) {
+        if (channels > kMaxChannels) {
+            channels = kMaxChannels;
+        }
+        const SessionAudio audio = { sampleRate, frames, channels };
+        Chunk chunks[1 + kMaxChannels];
+        chunks[0] = { &audio, sizeof(audio) };
+        for (uint32_t channel = 0; channel < channels; ++channel) {
+            chunks[1 + channel] = { inputs[channel], frames * sizeof(float) };
+        }
+        append(SESSION_AUDIO, chunks, 1 + channels, true);
+    }
+
+    uint64_t getRecordCount() const { return fRecords.load(std::memory_order_relaxed); }
+    uint64_t getDroppedCount() const { return fDropped.load(std::memory_order_relaxed); }
+
+private:
+    struct Chunk {
+        const void* data;
+        size_t size;
+    };
+
+    SessionRecorder()
+        : fFile(nullptr),
+          fStartNs(hostTimeNs()),
+          fBytesWritten(0),
+          fRunning(false),
+          fRecords(0),
+          fDropped(0)
+    {
+        for (auto& owner : fOwners) {
+            owner.store(nullptr, std::memory_order_relaxed);
+        }
+
+        const char* path = std::getenv("FATSAT_RECORD_SESSION");
+        if (!path || *path == '\0') {
+            return;
+        }
+
+        fFile = fopen(path, "wb");
+        if (!fFile) {
+            fprintf(stderr, "[FatSat] Cannot open session log %s\n", path);
+            return;
+        }
+        fPath = path;
+
+        const SessionFileHeader header = { kSessionMagic, kSessionVersion };
+        fwrite(&header, sizeof(header), 1, fFile);
+
+        fBuffer.reserve(kBufferBytes);
+        fWriteBuffer.reserve(kBufferBytes);
+
+        fRunning = true;
+        fWriter = std::thread([this] { writerLoop(); });
+
+        fprintf(stdout, "[FatSat] Recording session to %s\n", path);
+    }
+
+    ~SessionRecorder() {
+        if (!fFile) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(fWakeMutex);
+            fRunning = false;
+        }
+        fWake.notify_one();
+        fWriter.join();
+        flush();
+        fclose(fFile);
+
+        fprintf(stdout, "[FatSat] Session log %s: %llu records, %.1f MiB\n", fPath.c_str(),
+                (unsigned long long)getRecordCount(), fBytesWritten / 1048576.0);
+        if (getDroppedCount() > 0) {
+            fprintf(stderr, "[FatSat] Session log incomplete: %llu records dropped\n",
+                    (unsigned long long)getDroppedCount());
+        }
+    }
+
+    void append(SessionRecordType type, const Chunk* chunks, size_t count, bool realtime) {
+        if (!fFile) {
+            return;
+        }
+
+        size_t size = 0;
+        for (size_t i = 0; i < count; ++i) {
+            size += chunks[i].size;
+        }
+
+        std::unique_lock<std::mutex> lock(fBufferMutex, std::defer_lock);
+        if (realtime) {
+            if (!lock.try_lock()) {
+                fDropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        } else {
+            lock.lock();
+        }
+
+        // Never grow past the reserved capacity (no allocation under the lock)
+        if (fBuffer.size() + sizeof(SessionRecordHeader) + size > fBuffer.capacity()) {
+            fDropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        SessionRecordHeader header;
+        header.timeNs = hostTimeNs() - fStartNs;
+        header.size = static_cast<uint32_t>(size);
+        header.type = type;
+        std::memset(header.reserved, 0, sizeof(header.reserved));
+
+        const uint8_t* headerBytes = reinterpret_cast<const uint8_t*>(&header);
+        fBuffer.insert(fBuffer.end(), headerBytes, headerBytes + sizeof(header));
+        for (size_t i = 0; i < count; ++i) {
+            const uint8_t* bytes = static_cast<const uint8_t*>(chunks[i].data);
+            fBuffer.insert(fBuffer.end(), bytes, bytes + chunks[i].size);
+        }
+        fRecords.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void writerLoop() {
+        std::unique_lock<std::mutex> lock(fWakeMutex);
+        while (fRunning) {
+            fWake.wait_for(lock, std::chrono::milliseconds(kFlushIntervalMs));
+            lock.unlock();
+            flush();
+            lock.lock();
+        }
+    }
+
+    // Writer thread (or destructor after it stopped)
+    void flush() {
+        {
+            std::lock_guard<std::mutex> lock(fBufferMutex);
+            fBuffer.swap(fWriteBuffer);
+        }
+        if (!fWriteBuffer.empty()) {
+            fwrite(fWriteBuffer.data(), 1, fWriteBuffer.size(), fFile);
+            fflush(fFile);
+            fBytesWritten += fWriteBuffer.size();
+            fWriteBuffer.clear();
+        }
+    }
+
+    FILE* fFile;
+    std::string fPath;
+    const uint64_t fStartNs;
+    uint64_t fBytesWritten;
+
+    std::atomic<const void*> fOwners[SESSION_SOURCE_COUNT];
+
+    // Records since the last flush / being written
+    std::mutex fBufferMutex;
+    std::vector<uint8_t> fBuffer;
+    std::vector<uint8_t> fWriteBuffer;
+
+    std::thread fWriter;
+    std::mutex fWakeMutex;
+    std::condition_variable fWake;
+    bool fRunning;
+
+    std::atomic<uint64_t> fRecords;
+    std::atomic<uint64_t> fDropped;
+
+    SessionRecorder(const SessionRecorder&) = delete;
+    SessionRecorder& operator=(const SessionRecorder&) = delete;
+};
+
+// Reads a whole session log into memory and walks its records
+class SessionReader {
+public:
+    SessionReader() : fOffset(0) {}
+
+    bool open(const char* path) {
+        FILE* file = fopen(path, "rb");
+        if (!file) {
+            fprintf(stderr, "[Session] Cannot open %s\n", path);
+            return false;
+        }
+
+        fseek(file, 0, SEEK_END);
+        const long length = ftell(file);
+        fseek(file, 0, SEEK_SET);
+
+        fData.resize(length > 0 ? static_cast<size_t>(length) : 0);
+        const size_t read = fData.empty() ? 0 : fread(fData.data(), 1, fData.size(), file);
+        fclose(file);
+
+        SessionFileHeader header;
+        if (read != fData.size() || fData.size() < sizeof(header)) {
+            fprintf(stderr, "[Session] %s is truncated\n", path);
+            return false;
+        }
+        std::memcpy(&header, fData.data(), sizeof(header));
+        if (header.magic != kSessionMagic || header.version != kSessionVersion) {
+            fprintf(stderr, "[Session] %s is not a version %u session log\n", path, kSessionVersion);
+            return false;
+        }
+
+        rewind();
+        return true;
+    }
+
+    void rewind() {
+        fOffset = sizeof(SessionFileHeader);
+    }
+
+    // Next record; payload points into the reader's memory
+    // Returns false at the end of the log (or at a truncated last record)
+    bool next(SessionRecordHeader& header, const uint8_t*& payload) {
+        if (fOffset + sizeof(header) > fData.size()) {
+            return false;
+        }
+        std::memcpy(&header, fData.data() + fOffset, sizeof(header));
+        if (fOffset + sizeof(header) + header.size > fData.size()) {
+            return false;
+        }
+        payload = fData.data() + fOffset + sizeof(header);
+        fOffset += sizeof(header) + header.size;
+        return true;
+    }
+
+private:
+    std::vector<uint8_t> fData;
+    size_t fOffset;
+};
+
+} // namespace enlil
+
+#endif // SESSION_LOG_HPP
@@ -0,0 +1,178 @@
+/*
+ * DSP Table Cache - Process-wide shared read-only tables and coefficients
+ * Part of the Enlil/GodotVST Framework
+ *
+ * Filter coefficients, interpolators and curve tables depend only on a few
+ * parameters, so every instance in the process can share one copy instead
+ * of building its own. A table is built on first use, under the cache
+ * lock, and handed out as a reference-counted pointer to const; it is
+ * freed when the last instance lets go of it.
+ *
+ * Keys are the table's type plus the parameters it was built from:
+ * oversampling factor, size, sample rate (0 when it does not matter) and
+ * an id for content-defined tables (e.g. a curve's point hash). One key
+ * type maps to one C++ type. Content-defined tables also hand their content
+ * to acquire(); the entry keeps a copy and compares it on a hit, so two
+ * contents whose hashes collide still get tables of their own.
+ *
+ * Acquire and drop references off the audio thread (constructors,
+ * setState(), BlobChannel reclamation): dropping the last one frees the
+ * table. The audio thread only reads through the raw pointer.
+ */
+
+#ifndef TABLE_CACHE_HPP
+#define TABLE_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace enlil {
+
+enum DSPTableType {
+    DSP_TABLE_HALFBAND,   // Saturator: 2x halfband FIR taps
+    DSP_TABLE_TRUE_PEAK,  // LookaheadLimiter: 4x interpolator phases
+    DSP_TABLE_CURVE       // CurveTable of a drawn curve
+};
+
+struct DSPTableKey {
+    DSPTableType type;
+    uint32_t factor;      // oversampling factor, 1 if none
+    uint32_t size;        // taps or knots
+    double sampleRate;    // 0 if the table does not depend on it
+    uint64_t id;          // content hash for content-defined tables, else 0
+
+    bool operator==(const DSPTableKey& other) const {
+        return type == other.type && factor == other.factor && size == other.size &&
+               sampleRate == other.sampleRate && id == other.id;
+    }
+};
+
+// FNV-1a, for content ids
+inline uint64_t hashTableContent(const void* data, size_t bytes, uint64_t hash = 14695981039346656037ull) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < bytes; ++i) {
+        hash = (hash ^ p[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+class DSPTableCache {
+public:
+    struct Stats {
+        size_t tables;       // live tables
+        size_t bytes;        // their memory
+        size_t references;   // holders across all instances
+        size_t bytesSaved;   // what per-holder copies would have cost on top
+        uint64_t builds;     // tables built since startup
+        uint64_t hits;       // acquisitions served from the cache
+    };
+
+    static DSPTableCache& instance() {
+        static DSPTableCache cache;
+        return cache;
+    }
+
+    // The table for key, built with build(T&) on a default-constructed T
+    // if no instance holds it yet. Not on the audio thread.
+    template<typename T, typename Build>
+    std::shared_ptr<const T> acquire(const DSPTableKey& key, Build build) {
+        return acquire<T>(key, nullptr, 0, build);
+    }
+
+    // The same for a content-defined table: a cached table is only reused
+    // if it was built from the same contentBytes bytes at content
+    template<typename T, typename Build>
+    std::shared_ptr<const T> acquire(const DSPTableKey& key, const void* content,
+                                     size_t contentBytes, Build build) {
+        std::lock_guard<std::mutex> lock(fMutex);
+
+        for (Entry& entry : fEntries) {
+            if (entry.key == key && entry.content.size() == contentBytes &&
+                (contentBytes == 0 || std::memcmp(entry.content.data(), content, contentBytes) == 0)) {
+                if (std::shared_ptr<const void> table = entry.table.lock()) {
+                    fHits++;
+                    return std::static_pointer_cast<const T>(table);
+                }
+            }
+        }
+        prune();
+
+        std::shared_ptr<T> table = std::make_shared<T>();
+        build(*table);
+        const unsigned char* bytes = static_cast<const unsigned char*>(content);
+        fEntries.push_back({key, std::weak_ptr<const void>(table), sizeof(T),
+                            std::vector<unsigned char>(bytes, bytes + contentBytes)});
+        fBuilds++;
+        return table;
+    }
+
+    Stats getStats() {
+        std::lock_guard<std::mutex> lock(fMutex);
+        prune();
+
+        Stats stats = {};
+        for (const Entry& entry : fEntries) {
+            const size_t references = static_cast<size_t>(entry.table.use_count());
+            if (references == 0) {
+                continue; // released since prune()
+            }
+            stats.tables++;
+            stats.bytes += entry.bytes;
+            stats.references += references;
+            stats.bytesSaved += entry.bytes * (references - 1);
+        }
+        stats.builds = fBuilds;
+        stats.hits = fHits;
+        return stats;
+    }
+
+    void printStats(FILE* file, const char* prefix) {
+        const Stats stats = getStats();
+        fprintf(file, "%s Shared DSP tables: %zu (%.1f KB), %zu references, %.1f KB saved, "
+                      "%llu built, %llu shared\n",
+                prefix, stats.tables, stats.bytes / 1024.0, stats.references,
+                stats.bytesSaved / 1024.0, static_cast<unsigned long long>(stats.builds),
+                static_cast<unsigned long long>(stats.hits));
+    }
+
+private:
+    struct Entry {
+        DSPTableKey key;
+        std::weak_ptr<const void> table;
+        size_t bytes;
+        std::vector<unsigned char> content; // empty unless content-defined
+    };
+
+    DSPTableCache() : fBuilds(0), fHits(0) {}
+
+    // Forget tables nobody holds any more (already freed)
+    void prune() {
+        size_t kept = 0;
+        for (size_t i = 0; i < fEntries.size(); ++i) {
+            if (!fEntries[i].table.expired()) {
+                if (i != kept) {
+                    fEntries[kept] = std::move(fEntries[i]);
+                }
+                kept++;
+            }
+        }
+        fEntries.resize(kept);
+    }
+
+    std::mutex fMutex;
+    std::vector<Entry> fEntries;
+    uint64_t fBuilds;
+    uint64_t fHits;
+
+    DSPTableCache(const DSPTableCache&) = delete;
+    DSPTableCache& operator=(const DSPTableCache&) = delete;
+};
+
+} // namespace enlil
+
+#endif // TABLE_CACHE_HPP
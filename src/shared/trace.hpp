@@ -0,0 +1,325 @@
+/*
+ * Trace - Cross-thread timeline tracing with Chrome trace-event export
+ * Part of the Enlil/GodotVST Framework
+ *
+ * Compile-time optional: unless ENLIL_TRACE is defined, the macros below
+ * expand to nothing and this header costs nothing.
+ *
+ * Every thread that records gets its own fixed-size ring of events from a
+ * static pool. A buffer is claimed once per thread with a compare-exchange
+ * and is written by that thread only, so recording is wait-free and never
+ * locks - safe on the audio thread. When a ring wraps, the oldest events
+ * are overwritten. A thread gives its buffer back when it exits, so hosts
+ * that recreate worker threads keep being traced. Unused buffers are
+ * claimed first; reclaiming an exited thread's buffer starts a fresh ring,
+ * so that thread's events are dropped rather than exported under the new
+ * owner's name.
+ *
+ * dump() writes all threads to one Chrome trace-event JSON file, viewable
+ * in chrome://tracing or ui.perfetto.dev. If FATSAT_TRACE_FILE is set in
+ * the environment, the trace is also written there when the binary unloads.
+ *
+ *   ENLIL_TRACE_THREAD("audio");        // name the calling thread
+ *   ENLIL_TRACE_SCOPE("FatSatPlugin::run"); // zone until end of scope
+ *   ENLIL_TRACE_INSTANT("xrun");        // zero-length marker
+ *   ENLIL_TRACE_DUMP("/tmp/fatsat.json"); // write the trace now
+ *
+ * Zone names must be string literals (or otherwise outlive the tracer);
+ * use intern() for names built at runtime.
+ */
+
+#ifndef ENLIL_TRACE_HPP
+#define ENLIL_TRACE_HPP
+
+#ifdef ENLIL_TRACE
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+#include "frame_bridge.hpp"
+
+namespace enlil {
+
+class Tracer {
+public:
+    static constexpr uint32_t kMaxThreads = 16;
+    static constexpr uint32_t kEventsPerThread = 16384; // power of two
+    static constexpr uint32_t kMaxOpenZones = 32;
+    static constexpr uint32_t kMaxInternedNames = 128;
+    static constexpr uint32_t kMaxNameLength = 48;
+
+    struct Event {
+        const char* name;
+        uint64_t beginNs;
+        uint64_t endNs; // == beginNs for instant events
+    };
+
+    static Tracer& instance() {
+        static Tracer inst;
+        return inst;
+    }
+
+    // Record a finished zone (any thread, RT-safe)
+    void recordZone(const char* name, uint64_t beginNs, uint64_t endNs) {
+        ThreadBuffer* buffer = threadBuffer();
+        if (!buffer) {
+            return;
+        }
+        const uint32_t index = buffer->writeIndex.load(std::memory_order_relaxed);
+        Event& event = buffer->events[index & (kEventsPerThread - 1)];
+        event.name = name;
+        event.beginNs = beginNs;
+        event.endNs = endNs;
+        buffer->writeIndex.store(index + 1, std::memory_order_release);
+    }
+
+    void recordInstant(const char* name) {
+        const uint64_t now = hostTimeNs();
+        recordZone(name, now, now);
+    }
+
+    // Open/close a zone across calls, for callers that cannot use a scope
+    // (GDScript). Zones nest per thread; unbalanced ends are ignored.
+    void beginZone(const char* name) {
+        ThreadBuffer* buffer = threadBuffer();
+        if (!buffer || buffer->openZoneCount >= kMaxOpenZones) {
+            return;
+        }
+        buffer->openZones[buffer->openZoneCount].name = name;
+        buffer->openZones[buffer->openZoneCount].beginNs = hostTimeNs();
+        buffer->openZoneCount++;
+    }
+
+    void endZone() {
+        ThreadBuffer* buffer = threadBuffer();
+        if (!buffer || buffer->openZoneCount == 0) {
+            return;
+        }
+        buffer->openZoneCount--;
+        const Event& open = buffer->openZones[buffer->openZoneCount];
+        recordZone(open.name, open.beginNs, hostTimeNs());
+    }
+
+    // Name the calling thread in the exported trace
+    void setThreadName(const char* name) {
+        ThreadBuffer* buffer = threadBuffer();
+        if (!buffer) {
+            return;
+        }
+        std::strncpy(buffer->name, name, kMaxNameLength - 1);
+        buffer->name[kMaxNameLength - 1] = '\0';
+    }
+
+    // Copy a runtime string into a stable name (not RT-safe, locks).
+    // Returns the same pointer for equal strings; "(overflow)" when full.
+    const char* intern(const char* name) {
+        std::lock_guard<std::mutex> lock(fInternMutex);
+        for (uint32_t i = 0; i < fInternedCount; ++i) {
+            if (std::strncmp(fInterned[i], name, kMaxNameLength - 1) == 0) {
+                return fInterned[i];
+            }
+        }
+        if (fInternedCount >= kMaxInternedNames) {
+            return "(overflow)";
+        }
+        char* slot = fInterned[fInternedCount++];
+        std::strncpy(slot, name, kMaxNameLength - 1);
+        slot[kMaxNameLength - 1] = '\0';
+        return slot;
+    }
+
+    // Write every thread's events as Chrome trace-event JSON.
+    // Threads may keep recording while this runs; the oldest events of a
+    // ring that wraps during the dump may be torn, so a margin is skipped.
+    bool dump(const char* path) {
+        FILE* file = std::fopen(path, "w");
+        if (!file) {
+            fprintf(stderr, "[FatSat] Cannot open trace file %s for writing\n", path);
+            return false;
+        }
+
+        std::fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+        bool first = true;
+        size_t written = 0;
+
+        for (uint32_t t = 0; t < kMaxThreads; ++t) {
+            ThreadBuffer& buffer = fBuffers[t];
+            const uint32_t end = buffer.writeIndex.load(std::memory_order_acquire);
+            if (!buffer.claimed.load(std::memory_order_acquire) && end == 0) {
+                continue;
+            }
+
+            std::fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+                               "\"args\":{\"name\":\"", first ? "" : ",\n", t + 1);
+            writeEscaped(file, buffer.name[0] != '\0' ? buffer.name : "thread");
+            std::fprintf(file, "\"}}");
+            first = false;
+
+            uint32_t begin = 0;
+            if (end > kEventsPerThread) {
+                begin = end - kEventsPerThread + kDumpMargin;
+            }
+
+            for (uint32_t i = begin; i < end; ++i) {
+                const Event event = buffer.events[i & (kEventsPerThread - 1)];
+                if (!event.name) {
+                    continue;
+                }
+                std::fprintf(file, ",\n{\"name\":\"");
+                writeEscaped(file, event.name);
+                if (event.endNs == event.beginNs) {
+                    std::fprintf(file, "\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%u,\"ts\":%.3f}",
+                                 t + 1, static_cast<int64_t>(event.beginNs - fEpochNs) / 1000.0);
+                } else {
+                    std::fprintf(file, "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                                 t + 1, static_cast<int64_t>(event.beginNs - fEpochNs) / 1000.0,
+                                 (event.endNs - event.beginNs) / 1000.0);
+                }
+                written++;
+            }
+        }
+
+        std::fprintf(file, "\n]}\n");
+        std::fclose(file);
+
+        fprintf(stderr, "[FatSat] Wrote %zu trace events to %s\n", written, path);
+        return true;
+    }
+
+private:
+    // Events skipped at the old end of a wrapped ring during dump()
+    static constexpr uint32_t kDumpMargin = 256;
+
+    struct ThreadBuffer {
+        std::atomic<bool> claimed; // owned by a live thread
+        std::atomic<uint32_t> writeIndex;
+        char name[kMaxNameLength];
+
+        // Owner thread only
+        Event openZones[kMaxOpenZones];
+        uint32_t openZoneCount;
+
+        Event events[kEventsPerThread];
+    };
+
+    Tracer() : fEpochNs(hostTimeNs()), fInternedCount(0) {}
+
+    ~Tracer() {
+        if (const char* path = std::getenv("FATSAT_TRACE_FILE")) {
+            dump(path);
+        }
+    }
+
+    // Returns the thread's buffer to the pool when the thread exits
+    struct ThreadLease {
+        ThreadBuffer* buffer = nullptr;
+        bool claimed = false;
+
+        ~ThreadLease() {
+            if (buffer) {
+                buffer->claimed.store(false, std::memory_order_release);
+            }
+        }
+    };
+
+    // The calling thread's buffer, claimed on first use (nullptr if every
+    // buffer is held by a live thread; that thread is then not traced).
+    // The first call on a thread registers the lease's destructor, which
+    // may allocate once.
+    ThreadBuffer* threadBuffer() {
+        static thread_local ThreadLease tLease;
+        if (!tLease.claimed) {
+            tLease.claimed = true;
+            tLease.buffer = claimBuffer(false);
+            if (!tLease.buffer) {
+                tLease.buffer = claimBuffer(true);
+            }
+        }
+        return tLease.buffer;
+    }
+
+    // Claim a free buffer: one never recorded into, or with recycle one an
+    // exited thread left behind, emptied for the new owner
+    ThreadBuffer* claimBuffer(bool recycle) {
+        for (uint32_t t = 0; t < kMaxThreads; ++t) {
+            ThreadBuffer& buffer = fBuffers[t];
+            if (!recycle && buffer.writeIndex.load(std::memory_order_relaxed) != 0) {
+                continue;
+            }
+            bool expected = false;
+            if (buffer.claimed.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+                buffer.writeIndex.store(0, std::memory_order_release);
+                buffer.name[0] = '\0';
+                buffer.openZoneCount = 0;
+                return &buffer;
+            }
+        }
+        return nullptr;
+    }
+
+    static void writeEscaped(FILE* file, const char* text) {
+        for (; *text != '\0'; ++text) {
+            const char c = *text;
+            if (c == '"' || c == '\\') {
+                std::fputc('\\', file);
+                std::fputc(c, file);
+            } else if (static_cast<unsigned char>(c) >= 0x20) {
+                std::fputc(c, file);
+            }
+        }
+    }
+
+    const uint64_t fEpochNs;
+
+    // Left to static zero-initialization (no initializer, so nothing is
+    // written at construction); only pages of buffers that are actually
+    // recorded into become resident
+    ThreadBuffer fBuffers[kMaxThreads];
+
+    std::mutex fInternMutex;
+    char fInterned[kMaxInternedNames][kMaxNameLength];
+    uint32_t fInternedCount;
+
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+};
+
+// Records a zone from construction to end of scope
+class TraceScope {
+public:
+    explicit TraceScope(const char* name) : fName(name), fBeginNs(hostTimeNs()) {}
+    ~TraceScope() { Tracer::instance().recordZone(fName, fBeginNs, hostTimeNs()); }
+
+private:
+    const char* const fName;
+    const uint64_t fBeginNs;
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+};
+
+} // namespace enlil
+
+#define ENLIL_TRACE_CONCAT_INNER(a, b) a##b
+#define ENLIL_TRACE_CONCAT(a, b) ENLIL_TRACE_CONCAT_INNER(a, b)
+
+#define ENLIL_TRACE_SCOPE(name) \
+    ::enlil::TraceScope ENLIL_TRACE_CONCAT(enlilTraceScope_, __LINE__)(name)
+#define ENLIL_TRACE_INSTANT(name) ::enlil::Tracer::instance().recordInstant(name)
+#define ENLIL_TRACE_THREAD(name) ::enlil::Tracer::instance().setThreadName(name)
+#define ENLIL_TRACE_DUMP(path) ::enlil::Tracer::instance().dump(path)
+
+#else // !ENLIL_TRACE
+
+#define ENLIL_TRACE_SCOPE(name) ((void)0)
+#define ENLIL_TRACE_INSTANT(name) ((void)0)
+#define ENLIL_TRACE_THREAD(name) ((void)0)
+#define ENLIL_TRACE_DUMP(path) false
+
+#endif // ENLIL_TRACE
+
+#endif // ENLIL_TRACE_HPP
@@ -0,0 +1,266 @@
+/*
+ * UI Frame Scheduler - Audio-load-aware render fidelity for the editor
+ * Part of the Enlil/GodotVST Framework
+ *
+ * The Godot UI renders on the same cores as the host's audio threads. The
+ * scheduler watches the signals that say audio is short on time:
+ * - this instance's DSP load and peak (its output parameters)
+ * - deadline overruns of this instance and of every meter in the process
+ * - system CPU pressure (Linux PSI, /proc/pressure/cpu "some avg10")
+ * and the UI thread's own busy time per wall time (engine iteration plus
+ * the host-side blit), in percent of one core.
+ *
+ * While audio is under pressure the UI gets a CPU budget: the frame
+ * interval is stretched until the measured UI load fits it, to at least
+ * half the frame rate, and to a quarter after an overrun. At the lowest
+ * level idle frames are read back less often and animations pause. Once
+ * pressure has stayed low for kRecoverHoldNs the interval is halved, step
+ * by step, back to full fidelity.
+ *
+ * Defaults are overridable with FATSAT_UI_CPU_BUDGET (percent of a core)
+ * and FATSAT_UI_SCHEDULER=0 (always full fidelity) in the environment.
+ *
+ * Single-threaded: call everything from the DPF UI thread.
+ */
+
+#ifndef UI_SCHEDULER_HPP
+#define UI_SCHEDULER_HPP
+
+#include "dsp_load.hpp"
+#include "frame_bridge.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+namespace enlil {
+
+class UIFrameScheduler {
+public:
+    // How often pressure and UI load are re-evaluated
+    static constexpr uint64_t kEvaluateIntervalNs = 250000000;
+
+    // Pressure must stay low this long before each restore step
+    static constexpr uint64_t kRecoverHoldNs = 1500000000;
+
+    // An overrun counts as pressure for this long
+    static constexpr uint64_t kOverrunHoldNs = 5000000000;
+
+    // Longest frame interval (4 fps)
+    static constexpr uint64_t kMaxFrameIntervalNs = 250000000;
+
+    // Instance DSP load in percent of the block budget: at or above the
+    // high marks audio is under pressure, below the low marks it is not
+    static constexpr float kHighLoad = 70.0f;
+    static constexpr float kHighPeakLoad = 90.0f;
+    static constexpr float kLowLoad = 50.0f;
+    static constexpr float kLowPeakLoad = 70.0f;
+
+    // System CPU pressure (share of time some task waited for a CPU, %)
+    static constexpr float kHighCpuPressure = 20.0f;
+    static constexpr float kLowCpuPressure = 5.0f;
+
+    // Share of one core the UI may use while audio is under pressure
+    static constexpr float kDefaultBudgetPercent = 15.0f;
+
+    explicit UIFrameScheduler(uint64_t baseFrameIntervalNs)
+        : fEnabled(true),
+          fBudgetPercent(kDefaultBudgetPercent),
+          fBaseIntervalNs(baseFrameIntervalNs > 0 ? baseFrameIntervalNs : 1),
+          fIntervalNs(fBaseIntervalNs),
+          fQuality(UI_QUALITY_FULL),
+          fUnderPressure(false),
+          fDspLoad(0.0f),
+          fDspLoadPeak(0.0f),
+          fCpuPressure(-1.0f),
+          fUiLoad(0.0f),
+          fInstanceOverruns(0),
+          fSeenInstanceOverruns(0),
+          fHaveOverrunBaseline(false),
+          fSeenProcessOverruns(DSPLoadMeter::getProcessOverrunCount()),
+          fLastOverrunNs(0),
+          fCalmSinceNs(0),
+          fWindowStartNs(0),
+          fWindowBusyNs(0)
+    {
+        if (const char* value = std::getenv("FATSAT_UI_SCHEDULER")) {
+            fEnabled = std::atoi(value) != 0;
+        }
+        if (const char* value = std::getenv("FATSAT_UI_CPU_BUDGET")) {
+            const float percent = static_cast<float>(std::atof(value));
+            if (percent > 0.0f) {
+                fBudgetPercent = percent;
+            }
+        }
+    }
+
+    // === Signals ===
+
+    // Instance DSP load and window peak, percent of the block budget
+    void setDspLoad(float load, float peak) {
+        fDspLoad = load;
+        fDspLoadPeak = peak;
+    }
+
+    // Total deadline overruns reported by this instance; the first report
+    // is the baseline (overruns from before the editor opened)
+    void setDspOverruns(uint64_t count) {
+        if (!fHaveOverrunBaseline) {
+            fSeenInstanceOverruns = count;
+            fHaveOverrunBaseline = true;
+        }
+        fInstanceOverruns = count;
+    }
+
+    // UI thread time spent on a frame (engine iteration, upload, draw)
+    void addBusyTime(uint64_t nanoseconds) {
+        fWindowBusyNs += nanoseconds;
+    }
+
+    // Re-evaluate at most every kEvaluateIntervalNs; returns true when
+    // the frame interval or quality changed
+    bool update(uint64_t nowNs) {
+        if (!fEnabled) {
+            return false;
+        }
+        if (fWindowStartNs == 0) {
+            fWindowStartNs = nowNs;
+            return false;
+        }
+        if (nowNs - fWindowStartNs < kEvaluateIntervalNs) {
+            return false;
+        }
+
+        fUiLoad = static_cast<float>(fWindowBusyNs * 100.0 / (nowNs - fWindowStartNs));
+        fWindowStartNs = nowNs;
+        fWindowBusyNs = 0;
+
+        const uint64_t processOverruns = DSPLoadMeter::getProcessOverrunCount();
+        if (fInstanceOverruns > fSeenInstanceOverruns || processOverruns > fSeenProcessOverruns) {
+            fLastOverrunNs = nowNs;
+        }
+        fSeenInstanceOverruns = fInstanceOverruns;
+        fSeenProcessOverruns = processOverruns;
+
+        fCpuPressure = readCpuPressure();
+
+        const bool severe = fLastOverrunNs != 0 && nowNs - fLastOverrunNs < kOverrunHoldNs;
+        const bool high = severe || fDspLoad >= kHighLoad || fDspLoadPeak >= kHighPeakLoad ||
+                          fCpuPressure >= kHighCpuPressure;
+        const bool low = !severe && fDspLoad < kLowLoad && fDspLoadPeak < kLowPeakLoad &&
+                         fCpuPressure < kLowCpuPressure;
+
+        const uint64_t previousIntervalNs = fIntervalNs;
+
+        if (high) {
+            fUnderPressure = true;
+            fCalmSinceNs = 0;
+
+            // Busy time scales with the frame rate: stretch the interval
+            // until the UI fits its budget
+            uint64_t targetNs = fIntervalNs;
+            if (fUiLoad > fBudgetPercent) {
+                targetNs = static_cast<uint64_t>(fIntervalNs * (fUiLoad / fBudgetPercent));
+            }
+            targetNs = std::max(targetNs, fBaseIntervalNs * (severe ? 4 : 2));
+            fIntervalNs = std::min(targetNs, std::max(kMaxFrameIntervalNs, fBaseIntervalNs));
+        } else if (low) {
+            if (fCalmSinceNs == 0) {
+                fCalmSinceNs = nowNs;
+            } else if (nowNs - fCalmSinceNs >= kRecoverHoldNs && fIntervalNs > fBaseIntervalNs) {
+                fIntervalNs = std::max(fIntervalNs / 2, fBaseIntervalNs);
+                fCalmSinceNs = nowNs;
+            }
+            fUnderPressure = fIntervalNs > fBaseIntervalNs;
+        }
+        // In between the thresholds: hold the current level
+
+        const UIQuality previousQuality = fQuality;
+        if (fIntervalNs <= fBaseIntervalNs) {
+            fQuality = UI_QUALITY_FULL;
+        } else if (fIntervalNs < fBaseIntervalNs * 4) {
+            fQuality = UI_QUALITY_REDUCED;
+        } else {
+            fQuality = UI_QUALITY_MINIMAL;
+        }
+
+        return fIntervalNs != previousIntervalNs || fQuality != previousQuality;
+    }
+
+    // === Decisions ===
+
+    UIQuality getQuality() const { return fQuality; }
+
+    // Shortest interval between engine frames
+    uint64_t getFrameIntervalNs() const { return fIntervalNs; }
+
+    // Rendered frames per readback when no input arrived (1 = every frame)
+    uint32_t getReadbackInterval() const { return fQuality == UI_QUALITY_MINIMAL ? 2 : 1; }
+
+    bool areAnimationsPaused() const { return fQuality == UI_QUALITY_MINIMAL; }
+    bool isUnderPressure() const { return fUnderPressure; }
+
+    // Last evaluated signals
+    float getUiLoad() const { return fUiLoad; }
+    float getCpuPressure() const { return fCpuPressure; }
+    float getBudget() const { return fBudgetPercent; }
+
+    static const char* getQualityName(UIQuality quality) {
+        switch (quality) {
+        case UI_QUALITY_FULL:    return "full";
+        case UI_QUALITY_REDUCED: return "reduced";
+        case UI_QUALITY_MINIMAL: return "minimal";
+        }
+        return "unknown";
+    }
+
+private:
+    // "some avg10" of /proc/pressure/cpu, -1 where PSI is not available
+    static float readCpuPressure() {
+#if defined(__linux__)
+        FILE* file = std::fopen("/proc/pressure/cpu", "r");
+        if (!file) {
+            return -1.0f;
+        }
+        float avg10 = -1.0f;
+        if (std::fscanf(file, "some avg10=%f", &avg10) != 1) {
+            avg10 = -1.0f;
+        }
+        std::fclose(file);
+        return avg10;
+#else
+        return -1.0f;
+#endif
+    }
+
+    bool fEnabled;
+    float fBudgetPercent;
+    const uint64_t fBaseIntervalNs;
+    uint64_t fIntervalNs;
+    UIQuality fQuality;
+    bool fUnderPressure;
+
+    // Signals
+    float fDspLoad;
+    float fDspLoadPeak;
+    float fCpuPressure;
+    float fUiLoad;
+    uint64_t fInstanceOverruns;
+    uint64_t fSeenInstanceOverruns;
+    bool fHaveOverrunBaseline;
+    uint64_t fSeenProcessOverruns;
+    uint64_t fLastOverrunNs;
+    uint64_t fCalmSinceNs;
+
+    // UI busy time of the current evaluation window
+    uint64_t fWindowStartNs;
+    uint64_t fWindowBusyNs;
+
+    UIFrameScheduler(const UIFrameScheduler&) = delete;
+    UIFrameScheduler& operator=(const UIFrameScheduler&) = delete;
+};
+
+} // namespace enlil
+
+#endif // UI_SCHEDULER_HPP